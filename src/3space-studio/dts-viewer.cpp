@@ -1,4 +1,5 @@
 #include <array>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <deque>
@@ -107,6 +108,7 @@ namespace studio
 
     try
     {
+      file_stream.first.format = factory.detect_format(file_stream.first, *file_stream.second);
       raw_view = factory.create_view(file_stream.first, *file_stream.second, archive);
     }
     catch (const std::exception& ex)
@@ -284,6 +286,16 @@ int main(int argc, char** argv)
   {
     auto search_path = fs::current_path();
     auto archive = studio::views::create_default_resource_explorer(search_path);
+    archive.load_index(fs::temp_directory_path() / "3space-studio" / "workspace.idx");
+
+    // Records the order files are opened in, for mkvol --optimise --trace.
+    const auto* trace_path = std::getenv("STUDIO_ACCESS_TRACE");
+    auto access_trace = std::make_shared<studio::resources::access_trace>();
+
+    if (trace_path != nullptr)
+    {
+      archive.set_access_trace(access_trace);
+    }
     auto view_factory = studio::views::create_default_view_factory();
 
     wxApp::SetInitializerFunction(studio::createApp);
@@ -325,6 +337,7 @@ int main(int argc, char** argv)
     auto tree_view = std::shared_ptr<wxTreeCtrl>(new wxTreeCtrl(tree_panel.get()), studio::default_wx_deleter);
 
     studio::populate_tree_view(view_factory, archive, *tree_view, search_path, extensions);
+    archive.save_index();
 
     auto get_filter_selection = [tree_search, &view_factory]() {
            const auto selection = tree_search->GetSelection();
@@ -582,6 +595,11 @@ int main(int argc, char** argv)
 
     auto result = app->OnRun();
 
+    if (trace_path != nullptr)
+    {
+      access_trace->save(trace_path);
+    }
+
     if (studio::sfml_initialised)
     {
       ImGui::SFML::Shutdown();
@@ -1,4 +1,5 @@
 #include <iomanip>
+#include <unordered_set>
 #include <wx/quantize.h>
 #include "bmp_view.hpp"
 #include "content/bmp/bitmap.hpp"
@@ -158,9 +159,24 @@ namespace studio::views
 
     palettes = manager.find_files(studio::resources::resource_explorer::get_archive_path(info.folder_path).parent_path(), { ".ppl", ".PPL", ".ipl", ".IPL", ".pal", ".PAL" });
 
-    auto all_palettes = manager.find_files({ ".ppl", ".ipl", ".pal" });
+    // Palettes from elsewhere are only offered once per name, taking the copy the game itself would load.
+    auto all_palettes = manager.get_overlay_index({ ".ppl", ".ipl", ".pal" });
 
-    studio::resources::resource_explorer::merge_results(palettes, all_palettes);
+    std::unordered_set<std::string> local_palettes;
+    local_palettes.reserve(palettes.size());
+
+    for (auto& palette_info : palettes)
+    {
+      local_palettes.emplace(studio::resources::normalise_path(palette_info.folder_path / palette_info.filename));
+    }
+
+    for (auto& palette_info : all_palettes->get_files())
+    {
+      if (local_palettes.count(studio::resources::normalise_path(palette_info.folder_path / palette_info.filename)) == 0)
+      {
+        palettes.emplace_back(palette_info);
+      }
+    }
 
     for (auto& palette_info : palettes)
     {
@@ -11,6 +11,7 @@
 #include "resources/darkstar_volume.hpp"
 #include "resources/three_space_volume.hpp"
 #include "resources/trophy_bass_volume.hpp"
+#include "resources/default_resource_explorer.hpp"
 
 namespace dio
 {
@@ -72,20 +73,6 @@ namespace studio::views
 
   studio::resources::resource_explorer create_default_resource_explorer(const std::filesystem::path& search_path)
   {
-    studio::resources::resource_explorer archive(search_path);
-
-    archive.add_archive_type(".mis", std::make_unique<dio::mis::darkstar::mis_file_archive>(), dio::mis::darkstar::mis_file_archive::supported_extensions);
-    archive.add_archive_type(".tbv", std::make_unique<dio::vol::trophy_bass::tbv_file_archive>());
-    archive.add_archive_type(".rbx", std::make_unique<dio::vol::trophy_bass::rbx_file_archive>());
-    archive.add_archive_type(".rmf", std::make_unique<dio::vol::three_space::rmf_file_archive>());
-    archive.add_archive_type(".map", std::make_unique<dio::vol::three_space::rmf_file_archive>());
-    archive.add_archive_type(".vga", std::make_unique<dio::vol::three_space::rmf_file_archive>());
-
-    // TODO fix issues with DYN extraction
-    //archive.add_archive_type(".dyn", std::make_unique<dio::vol::three_space::dyn_file_archive>());
-    archive.add_archive_type(".vol", std::make_unique<dio::vol::three_space::vol_file_archive>());
-    archive.add_archive_type(".vol", std::make_unique<dio::vol::darkstar::vol_file_archive>());
-
-    return archive;
+    return studio::resources::create_default_resource_explorer(search_path);
   }
 }
\ No newline at end of file
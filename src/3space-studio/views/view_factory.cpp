@@ -24,31 +24,64 @@ namespace studio::views
     return std::vector<std::string_view>(extensions.cbegin(), extensions.cend());
   }
 
-  std::unique_ptr<studio_view> view_factory::create_view(const studio::resources::file_info& file_info, std::basic_istream<std::byte>& stream, const studio::resources::resource_explorer& manager) const
+  stream_validator* view_factory::detect_format(const studio::resources::file_info& file_info, std::basic_istream<std::byte>& stream) const
   {
+    if (file_info.format != nullptr)
+    {
+      return file_info.format;
+    }
+
+    const auto key = file_info.folder_path / file_info.filename;
+    const auto source_path = std::filesystem::is_directory(file_info.folder_path) ? key : studio::resources::resource_explorer::get_archive_path(file_info.folder_path);
+
+    if (auto existing = formats->find(key, source_path); existing.has_value())
+    {
+      return existing.value();
+    }
+
+    const studio::resources::header_prefix header(stream);
+    stream_validator* result = nullptr;
+
     auto archive_type = validators.equal_range(shared::to_lower(file_info.filename.extension().string()));
 
     for (auto it = archive_type.first; it != archive_type.second; ++it)
     {
-      if (it->second(stream))
+      if (header.matches(it->second))
       {
-        return creators.at(it->second)(file_info, stream, manager);
+        result = it->second;
+        break;
       }
     }
 
-    for (auto& [checker, creator] : creators)
+    if (result == nullptr)
     {
-      if (auto allowed = no_fallback_allowed.find(checker); allowed != no_fallback_allowed.end())
+      for (auto& [checker, creator] : creators)
       {
-        return std::make_unique<default_view>(file_info);
-      }
+        if (auto allowed = no_fallback_allowed.find(checker); allowed != no_fallback_allowed.end())
+        {
+          break;
+        }
 
-      if (checker(stream))
-      {
-        return creator(file_info, stream, manager);
+        if (header.matches(checker))
+        {
+          result = checker;
+          break;
+        }
       }
     }
 
+    formats->insert(key, source_path, result);
+
+    return result;
+  }
+
+  std::unique_ptr<studio_view> view_factory::create_view(const studio::resources::file_info& file_info, std::basic_istream<std::byte>& stream, const studio::resources::resource_explorer& manager) const
+  {
+    if (auto checker = detect_format(file_info, stream); checker != nullptr)
+    {
+      return creators.at(checker)(file_info, stream, manager);
+    }
+
     return std::make_unique<default_view>(file_info);
   }
 
@@ -6,11 +6,12 @@
 #include "graphics_view.hpp"
 #include "default_view.hpp"
 #include "resources/resource_explorer.hpp"
+#include "resources/format_sniffer.hpp"
 #include "3space-studio/utility.hpp"
 
 namespace studio::views
 {
-  using stream_validator = bool(std::basic_istream<std::byte>&);
+  using stream_validator = studio::resources::stream_validator;
 
   using view_creator = std::unique_ptr<studio_view>(const studio::resources::file_info&, std::basic_istream<std::byte>&, const studio::resources::resource_explorer&);
 
@@ -23,6 +24,10 @@ namespace studio::views
 
     [[nodiscard]] std::vector<std::string_view> get_extensions() const;
 
+    // Finds the check which recognises a file, reading its header only once and remembering
+    // the result for as long as the file, or the archive holding it, is unchanged.
+    stream_validator* detect_format(const studio::resources::file_info& file_info, std::basic_istream<std::byte>& stream) const;
+
     std::unique_ptr<studio_view> create_view(const studio::resources::file_info& file_info, std::basic_istream<std::byte>& stream, const studio::resources::resource_explorer& manager) const;
 
     std::unique_ptr<studio_view> create_default_view(const studio::resources::file_info& file_info, std::basic_istream<std::byte>& stream, const studio::resources::resource_explorer& manager) const;
@@ -32,6 +37,7 @@ namespace studio::views
     std::set<stream_validator*> no_fallback_allowed;
     std::map<stream_validator*, view_creator*> creators;
     std::multimap<std::string_view, stream_validator*> validators;
+    std::unique_ptr<studio::resources::format_cache<stream_validator*>> formats = std::make_unique<studio::resources::format_cache<stream_validator*>>();
   };
 }// namespace studio::views
 
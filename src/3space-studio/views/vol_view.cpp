@@ -1,6 +1,7 @@
 #include <utility>
 #include <execution>
 #include <atomic>
+#include <wx/timer.h>
 #include <wx/treelist.h>
 #include <wx/filepicker.h>
 
@@ -52,13 +53,11 @@ namespace studio::views
           path = path / table->GetItemText(id, table->GetColumnCount() - 3).c_str().AsChar();
         }
 
-        auto original_info = std::find_if(files.begin(), files.end(), [&](auto& info) {
-          return info.folder_path == path && info.filename == table->GetItemText(id, 0).c_str().AsChar();
-        });
+        auto original_info = archive.find_file(path / table->GetItemText(id, 0).c_str().AsChar());
 
-        if (original_info != files.end())
+        if (original_info.has_value())
         {
-          archive.execute_action("open_new_tab", *original_info);
+          archive.execute_action("open_new_tab", original_info.value());
         }
       });
 
@@ -141,96 +140,134 @@ namespace studio::views
     });
 
     auto export_all_button = std::make_unique<wxButton>(panel.get(), wxID_ANY, "Extract All Volumes");
+    auto export_tar_button = std::make_unique<wxButton>(panel.get(), wxID_ANY, "Extract All Volumes to Tar");
 
-    export_all_button->Bind(wxEVT_BUTTON, [parent = &parent, this, folder_picker](wxCommandEvent& event) {
-      should_cancel = false;
-      auto dialog = std::make_unique<wxDialog>(parent, wxID_ANY, "Extracting All Volumes");
+    auto extract_all = [parent = &parent, this, folder_picker](wxCommandEvent& event, studio::resources::extraction_target target) {
+      // A cancelled run counts as finished straight away, but the task listing its files may still be going.
+      if ((extraction && !extraction->get_progress().finished) || (pending_save.valid() && pending_save.wait_for(std::chrono::seconds(0)) != std::future_status::ready))
+      {
+        event.Skip();
+        return;
+      }
+
+      auto dest = std::filesystem::path(folder_picker->GetPath().c_str().AsChar());
+      std::filesystem::create_directory(dest);
+
+      // Everything goes into one file when extracting to tar, which is much faster than creating thousands of small files on some drives.
+      studio::resources::extraction_options options{};
+      options.target = target;
+      // Extracting into the same folder again only writes what has changed since the last time.
+      options.incremental = true;
+      auto output = target == studio::resources::extraction_target::tar ? dest / "volumes.tar" : dest;
+
+      auto dialog = std::shared_ptr<wxDialog>(new wxDialog(parent, wxID_ANY, "Extracting All Volumes"), default_wx_deleter);
 
       auto dialog_sizer = std::make_unique<wxBoxSizer>(wxVERTICAL);
 
-      auto gauge = std::make_unique<wxGauge>(dialog.get(), wxID_ANY, 0);
+      auto gauge = std::make_unique<wxGauge>(dialog.get(), wxID_ANY, 1);
       gauge->SetWindowStyle(wxGA_HORIZONTAL);
 
-      auto text1 = std::make_unique<wxStaticText>(dialog.get(), wxID_ANY, "");
+      auto text1 = std::make_unique<wxStaticText>(dialog.get(), wxID_ANY, "Extracting to\n" + output.string());
       text1->SetWindowStyle(wxALIGN_CENTRE_HORIZONTAL);
 
       auto text2 = std::make_unique<wxStaticText>(dialog.get(), wxID_ANY, "");
       text2->SetWindowStyle(wxALIGN_CENTRE_HORIZONTAL);
       dialog_sizer->AddStretchSpacer(2);
-      dialog_sizer->Add(text1.get(), 2, wxEXPAND, 0);
+      dialog_sizer->Add(text1.release(), 2, wxEXPAND, 0);
       dialog_sizer->Add(gauge.get(), 2, wxEXPAND, 0);
       dialog_sizer->Add(text2.get(), 2, wxEXPAND, 0);
       dialog_sizer->AddStretchSpacer(2);
       dialog->SetSizer(dialog_sizer.release());
 
-      dialog->Bind(wxEVT_CLOSE_WINDOW, [=](auto&) {
-        should_cancel = true;
+      dialog->SetSize(dialog->GetSize().x + output.string().size(), dialog->GetSize().y);
+      dialog->CenterOnScreen();
+      dialog->Show();
+
+      auto scheduler = std::make_shared<studio::resources::extraction_scheduler>(archive, output, options);
+      extraction = scheduler;
+
+      // Each callback holds on to the scheduler of its own run, rather than whichever one the view has by then.
+      dialog->Bind(wxEVT_CLOSE_WINDOW, [scheduler](auto&) {
+        scheduler->cancel();
       });
 
-      pending_save = std::async(std::launch::async, [this, dialog = dialog.release(), folder_picker, text1 = text1.release(), text2 = text2.release(), gauge = gauge.release()] {
-        auto dest = std::filesystem::path(folder_picker->GetPath().c_str().AsChar());
-        std::filesystem::create_directory(dest);
-        auto scoped_dialog = std::unique_ptr<wxDialog>(dialog);
-        scoped_dialog->SetSize(scoped_dialog->GetSize().x + dest.string().size(), scoped_dialog->GetSize().y);
-        scoped_dialog->CenterOnScreen();
-        scoped_dialog->Show();
-        text1->SetLabel("Extracting to\n" + dest.string());
+      // The workers never touch the dialog. It is only updated from here, on the UI thread.
+      progress_timer = std::make_unique<wxTimer>();
+      progress_timer->Bind(wxEVT_TIMER, [this, scheduler, dialog, dest, gauge = gauge.release(), text2 = text2.release()](auto&) {
+        auto progress = scheduler->get_progress();
 
-        auto all_files = archive.find_files({ ".vol", ".rmf", ".rbx", ".tbv", ".mis" });
+        gauge->SetRange(int(std::max<std::size_t>(progress.total_files, 1)));
+        gauge->SetValue(int(progress.extracted_files + progress.failed_files + progress.skipped_files));
 
-        std::vector<std::pair<std::filesystem::path, std::vector<studio::resources::file_info>>> found_files(all_files.size());
+        if (!progress.current_file.empty())
+        {
+          text2->SetLabel(std::filesystem::relative(progress.current_file, archive.get_search_path()).string());
+        }
 
-        std::transform(std::execution::par, all_files.begin(), all_files.end(), found_files.begin(), [=](const auto& volume_file) {
-          static std::mutex gauge_mutex;
-          auto file_archive_path = volume_file.folder_path / volume_file.filename;
+        if (!progress.finished)
+        {
+          return;
+        }
 
-          auto child_files = archive.find_files(file_archive_path, { "ALL" });
+        progress_timer->Stop();
+        dialog->Hide();
+
+        if (auto errors = scheduler->get_errors(); !errors.empty())
+        {
+          auto message = errors.front();
+
+          if (errors.size() > 1)
           {
-            std::lock_guard<std::mutex> lock(gauge_mutex);
-            gauge->SetRange(gauge->GetRange() + child_files.size());
+            message += "\n\n(and " + std::to_string(errors.size() - 1) + " more errors)";
           }
 
-          return std::make_pair(file_archive_path, std::move(child_files));
-        });
+          wxMessageBox(message, "Error Extracting Volumes.", wxICON_ERROR);
+        }
+
+        if (!progress.cancelled && !opened_folder)
+        {
+          wxLaunchDefaultApplication(dest.string());
+          opened_folder = true;
+        }
+      });
+      progress_timer->Start(100);
 
-        std::for_each(std::execution::par_unseq, found_files.begin(), found_files.end(), [=](const auto& info) {
-          static std::mutex label_mutex;
-          static std::mutex gauge_mutex;
+      pending_save = std::async(std::launch::async, [this, scheduler] {
+        // Nobody waits on this future, so a failure here has to end the run itself, or the dialog would never close.
+        try
+        {
+          auto all_files = archive.find_files({ ".vol", ".rmf", ".rbx", ".tbv", ".mis" });
 
-          const auto& [file_archive_path, child_files] = info;
+          std::vector<std::vector<studio::resources::file_info>> found_files(all_files.size());
 
-          std::basic_ifstream<std::byte> archive_file(file_archive_path, std::ios::binary);
+          std::transform(std::execution::par, all_files.begin(), all_files.end(), found_files.begin(), [=](const auto& volume_file) {
+            return archive.find_files(volume_file.folder_path / volume_file.filename, { "ALL" });
+          });
 
-          for (const auto& file : child_files)
+          for (auto& child_files : found_files)
           {
-            if (should_cancel)
-            {
-              return;
-            }
-
-            {
-              std::lock_guard<std::mutex> lock(label_mutex);
-              text2->SetLabel((std::filesystem::relative(file.folder_path, archive.get_search_path()) / file.filename).string());
-            }
-
-            archive.extract_file_contents(archive_file, dest, file);
-
-            {
-              std::lock_guard<std::mutex> lock(gauge_mutex);
-              gauge->SetValue(gauge->GetValue() + 1);
-            }
+            scheduler->add_files(child_files);
           }
-        });
 
-        if (!opened_folder)
+          scheduler->start();
+        }
+        catch (const std::exception& ex)
         {
-          wxLaunchDefaultApplication(dest.string());
-          opened_folder = true;
+          scheduler->fail(ex.what());
+          return false;
         }
 
         return true;
       });
       event.Skip();
+    };
+
+    export_all_button->Bind(wxEVT_BUTTON, [extract_all](wxCommandEvent& event) {
+      extract_all(event, studio::resources::extraction_target::folders);
+    });
+
+    export_tar_button->Bind(wxEVT_BUTTON, [extract_all](wxCommandEvent& event) {
+      extract_all(event, studio::resources::extraction_target::tar);
     });
 
     panel->SetSizer(std::make_unique<wxBoxSizer>(wxHORIZONTAL).release());
@@ -240,7 +277,9 @@ namespace studio::views
     panel->GetSizer()->Add(export_button.release(), 2, wxEXPAND, 0);
     panel->GetSizer()->AddStretchSpacer(1);
     panel->GetSizer()->Add(export_all_button.release(), 2, wxEXPAND, 0);
-    panel->GetSizer()->AddStretchSpacer(12);
+    panel->GetSizer()->AddStretchSpacer(1);
+    panel->GetSizer()->Add(export_tar_button.release(), 2, wxEXPAND, 0);
+    panel->GetSizer()->AddStretchSpacer(9);
 
     auto sizer = std::make_unique<wxBoxSizer>(wxVERTICAL);
     sizer->Add(panel.release(), 1, wxEXPAND, 0);
@@ -2,8 +2,10 @@
 #define DARKSTARDTSCONVERTER_VOL_VIEW_HPP
 
 #include <future>
+#include <wx/timer.h>
 #include "graphics_view.hpp"
 #include "resources/resource_explorer.hpp"
+#include "resources/extraction_scheduler.hpp"
 
 namespace studio::views
 {
@@ -17,7 +19,9 @@ namespace studio::views
     const studio::resources::resource_explorer& archive;
     std::filesystem::path archive_path;
     std::vector<studio::resources::file_info> files;
+    std::shared_ptr<studio::resources::extraction_scheduler> extraction;
     std::future<bool> pending_save;
+    std::unique_ptr<wxTimer> progress_timer;
     bool should_cancel;
     bool opened_folder = false;
   };
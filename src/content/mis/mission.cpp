@@ -337,6 +337,7 @@ namespace studio::resources::mis::darkstar
   decltype(mis_file_archive::content_list_info)::iterator mis_file_archive::cache_data(std::basic_istream<std::byte>& stream,
     const std::filesystem::path& archive_or_folder_path) const
   {
+    std::lock_guard<std::mutex> lock(cache_mutex);
     auto archive_path = get_archive_path(archive_or_folder_path);
     auto existing_items = contents.find(archive_path);
 
@@ -423,6 +424,16 @@ namespace studio::resources::mis::darkstar
       {
         visit_item(std::nullopt, std::make_pair(archive_path, std::ref(result)));
       }
+
+      auto& lookup = file_lookup[archive_path];
+
+      for (auto i = 0u; i < existing_info->second.size(); ++i)
+      {
+        if (auto* file = std::get_if<studio::resources::file_info>(&existing_info->second[i].second); file != nullptr)
+        {
+          lookup.emplace(studio::resources::normalise_path(file->folder_path / file->filename), i);
+        }
+      }
     }
 
     return existing_info;
@@ -471,31 +482,27 @@ namespace studio::resources::mis::darkstar
     set_stream_position(stream, info);
     auto existing_info = cache_data(stream, info.folder_path);
 
-    for (auto& ref : existing_info->second)
+    std::optional<std::size_t> index;
+
     {
-      if (!std::visit([&](auto& child_info) -> bool {
-            if constexpr (std::is_same_v<std::decay_t<decltype(child_info)>, studio::resources::file_info>)
-            {
-              if (child_info.folder_path == info.folder_path && child_info.filename == info.filename)
-              {
-                return std::visit([&](auto& data) -> bool {
-                  if constexpr (std::is_same_v<std::decay_t<decltype(data)>, vehicle>)
-                  {
-                    write_vehicle(data, output);
-                    return false;
-                  }
-                  return true;
-                },
-                  ref.first.get());
-              }
-            }
+      std::lock_guard<std::mutex> lock(cache_mutex);
+      auto& lookup = file_lookup[existing_info->first];
 
-            return true;
-          },
-            ref.second))
+      if (auto item = lookup.find(studio::resources::normalise_path(info.folder_path / info.filename)); item != lookup.end())
       {
-        break;
+        index = item->second;
       }
     }
+
+    if (index.has_value())
+    {
+      std::visit([&](auto& data) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(data)>, vehicle>)
+        {
+          write_vehicle(data, output);
+        }
+      },
+        existing_info->second[index.value()].first.get());
+    }
   }
 }// namespace studio::resources::mis::darkstar
@@ -4,6 +4,8 @@
 #include <vector>
 #include <map>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 #include <optional>
 #include <istream>
 #include <variant>
@@ -198,6 +200,8 @@ namespace studio::resources::mis::darkstar
     using ref_vector = std::vector<std::pair<std::reference_wrapper<::studio::mis::darkstar::sim_item>, content_info>>;
     mutable std::map<std::filesystem::path, ::studio::mis::darkstar::sim_items> contents;
     mutable std::map<std::filesystem::path, ref_vector> content_list_info;
+    mutable std::map<std::filesystem::path, std::unordered_map<std::string, std::size_t>> file_lookup;
+    mutable std::mutex cache_mutex;
 
     decltype(content_list_info)::iterator mis_file_archive::cache_data(std::basic_istream<std::byte>& stream, const std::filesystem::path& archive_or_folder_path) const;
 
@@ -0,0 +1,314 @@
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <cstdlib>
+#include <optional>
+#include <vector>
+#include <string_view>
+
+#include <filesystem>
+#include "resources/darkstar_volume_writer.hpp"
+#include "resources/darkstar_volume_optimiser.hpp"
+#include "resources/access_trace.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  std::optional<studio::resources::compression_type> parse_compression(std::string_view value)
+  {
+    if (value == "none")
+    {
+      return studio::resources::compression_type::none;
+    }
+
+    if (value == "rle")
+    {
+      return studio::resources::compression_type::rle;
+    }
+
+    if (value == "lz")
+    {
+      return studio::resources::compression_type::lz;
+    }
+
+    if (value == "lzh")
+    {
+      return studio::resources::compression_type::lzh;
+    }
+
+    return std::nullopt;
+  }
+
+  // Volumes have no folders, so only the files directly inside a folder are added, in name order.
+  // The volume being written is left out, since it may sit in the same folder from an earlier run.
+  std::vector<fs::path> expand_input_paths(const std::vector<std::string_view>& arguments, const fs::path& volume_path)
+  {
+    std::vector<fs::path> results;
+
+    auto is_volume = [&](const fs::path& path) {
+      std::error_code error;
+      return fs::equivalent(path, volume_path, error);
+    };
+
+    for (auto argument : arguments)
+    {
+      fs::path path(argument);
+
+      if (!fs::is_directory(path))
+      {
+        if (!is_volume(path))
+        {
+          results.emplace_back(std::move(path));
+        }
+
+        continue;
+      }
+
+      std::vector<fs::path> files;
+
+      for (auto& item : fs::directory_iterator(path))
+      {
+        if (item.is_regular_file() && !is_volume(item.path()))
+        {
+          files.emplace_back(item.path());
+        }
+      }
+
+      std::sort(files.begin(), files.end());
+      results.insert(results.end(), files.begin(), files.end());
+    }
+
+    return results;
+  }
+
+  void print_layout(std::string_view label, const studio::resources::vol::darkstar::layout_stats& stats)
+  {
+    std::cout << std::setw(8) << label << ": " << stats.reads << " reads, " << stats.seeks << " seeks (" << stats.backward_seeks << " backwards), "
+              << double(stats.seek_distance) / (1024 * 1024) << " MB seek distance, " << stats.pages_touched << " pages touched, "
+              << stats.unaligned_entries << " unaligned entries\n";
+  }
+
+  int optimise(const fs::path& input_path, const fs::path& output_path, const studio::resources::vol::darkstar::optimise_options& options)
+  {
+    namespace darkstar = studio::resources::vol::darkstar;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    if (std::error_code error; fs::equivalent(input_path, output_path, error))
+    {
+      std::cerr << "The optimised volume must be written somewhere other than " << input_path << '\n';
+      return 1;
+    }
+
+    std::basic_ifstream<std::byte> input(input_path, std::ios::binary);
+
+    if (!input)
+    {
+      std::cerr << "Could not open " << input_path << '\n';
+      return 1;
+    }
+
+    darkstar::vol_writer_stats stats{};
+
+    // The new volume only replaces the output once it is complete, so a failure leaves whatever was there before.
+    auto temp_path = output_path;
+    temp_path += ".tmp";
+
+    try
+    {
+      std::basic_ofstream<std::byte> output(temp_path, std::ios::binary | std::ios::trunc);
+
+      if (!output)
+      {
+        std::cerr << "Could not create " << temp_path << '\n';
+        return 1;
+      }
+
+      stats = darkstar::optimise_volume(input, output, options);
+      output.close();
+
+      if (!output)
+      {
+        throw std::invalid_argument("Could not write " + temp_path.string());
+      }
+
+      fs::rename(temp_path, output_path);
+    }
+    catch (const std::exception& ex)
+    {
+      std::cerr << ex.what() << '\n';
+
+      std::error_code error;
+      fs::remove(temp_path, error);
+      return 1;
+    }
+
+    const auto seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-6);
+
+    std::basic_ifstream<std::byte> output(output_path, std::ios::binary);
+    const auto before_blocks = darkstar::get_volume_blocks(input);
+    const auto after_blocks = darkstar::get_volume_blocks(output);
+
+    // Without a trace, the report assumes entries are read in the new order, which is what grouping them is for.
+    auto access_order = options.trace;
+
+    if (options.order != darkstar::layout_order::trace)
+    {
+      access_order.clear();
+
+      for (auto& block : after_blocks)
+      {
+        access_order.emplace_back(block.info.filename.string());
+      }
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Rewrote " << stats.file_count << " files from " << input_path.string() << " into " << output_path.string() << " in " << seconds << "s, with "
+              << double(stats.padding_bytes) / (1024 * 1024) << " MB of padding\n";
+
+    print_layout("Before", darkstar::measure_layout(before_blocks, access_order));
+    print_layout("After", darkstar::measure_layout(after_blocks, access_order));
+
+    return 0;
+  }
+}
+
+int main(int argc, const char** argv)
+{
+  std::vector<std::string_view> arguments(argv + 1, argv + argc);
+  std::vector<std::string_view> input_arguments;
+  auto compression = studio::resources::compression_type::lz;
+  auto optimise_mode = false;
+  studio::resources::vol::darkstar::optimise_options optimise_options;
+  fs::path trace_path;
+
+  for (auto i = 0u; i < arguments.size(); ++i)
+  {
+    if (arguments[i] == "--compression" && i + 1 < arguments.size())
+    {
+      auto value = parse_compression(arguments[++i]);
+
+      if (!value.has_value())
+      {
+        std::cerr << "Unknown compression " << arguments[i] << ", expected none, rle, lz or lzh\n";
+        return 1;
+      }
+
+      compression = value.value();
+    }
+    else if (arguments[i] == "--optimise")
+    {
+      optimise_mode = true;
+    }
+    else if (arguments[i] == "--order" && i + 1 < arguments.size())
+    {
+      auto value = arguments[++i];
+
+      if (value != "original" && value != "type")
+      {
+        std::cerr << "Unknown order " << value << ", expected original or type\n";
+        return 1;
+      }
+
+      optimise_options.order = value == "original" ? studio::resources::vol::darkstar::layout_order::original : studio::resources::vol::darkstar::layout_order::type;
+    }
+    else if (arguments[i] == "--trace" && i + 1 < arguments.size())
+    {
+      trace_path = fs::path(arguments[++i]);
+    }
+    else if (arguments[i] == "--alignment" && i + 1 < arguments.size())
+    {
+      optimise_options.alignment = std::size_t(std::max(1, std::atoi(std::string(arguments[++i]).c_str())));
+    }
+    else if (arguments[i] == "--decompress")
+    {
+      optimise_options.decompress = true;
+    }
+    else
+    {
+      input_arguments.emplace_back(arguments[i]);
+    }
+  }
+
+  if (optimise_mode && input_arguments.size() == 2)
+  {
+    if (!trace_path.empty())
+    {
+      // Traces are recorded by 3Space Studio when STUDIO_ACCESS_TRACE names the file to write them to.
+      studio::resources::access_trace trace;
+
+      try
+      {
+        trace.load(trace_path);
+      }
+      catch (const std::exception& ex)
+      {
+        std::cerr << ex.what() << '\n';
+        return 1;
+      }
+
+      optimise_options.order = studio::resources::vol::darkstar::layout_order::trace;
+      optimise_options.trace = trace.get_filenames(input_arguments[0]);
+    }
+
+    return optimise(input_arguments[0], input_arguments[1], optimise_options);
+  }
+
+  if (optimise_mode || input_arguments.size() < 2)
+  {
+    std::cerr << "Usage: mkvol [--compression none|rle|lz|lzh] <output.vol> <file or folder>...\n"
+              << "       mkvol --optimise [--order original|type] [--trace trace.txt] [--alignment N] [--decompress] <input.vol> <output.vol>\n";
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const fs::path volume_path(input_arguments.front());
+  input_arguments.erase(input_arguments.begin());
+
+  studio::resources::vol::darkstar::vol_writer writer(compression);
+  studio::resources::vol::darkstar::vol_writer_stats stats{};
+
+  try
+  {
+    for (auto& path : expand_input_paths(input_arguments, volume_path))
+    {
+      writer.add_file(path);
+    }
+
+    std::basic_ofstream<std::byte> output(volume_path, std::ios::binary | std::ios::trunc);
+
+    if (!output)
+    {
+      std::cerr << "Could not create " << volume_path << '\n';
+      return 1;
+    }
+
+    stats = writer.write(output);
+    output.close();
+
+    if (!output)
+    {
+      throw std::invalid_argument("Could not write " + volume_path.string());
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cerr << ex.what() << '\n';
+
+    std::error_code error;
+    fs::remove(volume_path, error);
+    return 1;
+  }
+
+  const auto seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-6);
+  const auto megabytes = double(stats.uncompressed_bytes) / (1024 * 1024);
+
+  std::cout << std::fixed << std::setprecision(2)
+            << "Packed " << stats.file_count << " files (" << megabytes << " MB) into " << volume_path.string() << " in " << seconds << "s\n"
+            << "Compressed at " << stats.get_throughput() / (1024 * 1024) << " MB/s, stored at " << stats.get_ratio() * 100 << "% of the original size\n";
+
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include <fstream>
+#include <stdexcept>
+#include "access_trace.hpp"
+
+namespace studio::resources
+{
+  void access_trace::record(const file_info& info)
+  {
+    add(info.folder_path / info.filename);
+  }
+
+  void access_trace::add(std::filesystem::path path)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (seen.emplace(normalise_path(path)).second)
+    {
+      paths.emplace_back(std::move(path));
+    }
+  }
+
+  std::vector<std::filesystem::path> access_trace::get_paths() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return paths;
+  }
+
+  std::vector<std::string> access_trace::get_filenames(const std::filesystem::path& archive_path) const
+  {
+    const auto archive_key = normalise_path(std::filesystem::absolute(archive_path).lexically_normal());
+
+    std::vector<std::string> results;
+
+    for (auto& path : get_paths())
+    {
+      if (normalise_path(std::filesystem::absolute(path.parent_path()).lexically_normal()) == archive_key)
+      {
+        results.emplace_back(path.filename().string());
+      }
+    }
+
+    return results;
+  }
+
+  void access_trace::save(const std::filesystem::path& trace_path) const
+  {
+    std::ofstream output(trace_path, std::ios::trunc);
+
+    for (auto& path : get_paths())
+    {
+      output << path.generic_u8string() << '\n';
+    }
+
+    if (!output)
+    {
+      throw std::invalid_argument("Could not write " + trace_path.string());
+    }
+  }
+
+  void access_trace::load(const std::filesystem::path& trace_path)
+  {
+    std::ifstream input(trace_path);
+
+    if (!input)
+    {
+      throw std::invalid_argument("Could not open " + trace_path.string());
+    }
+
+    std::string line;
+
+    while (std::getline(input, line))
+    {
+      if (!line.empty() && line.back() == '\r')
+      {
+        line.pop_back();
+      }
+
+      if (!line.empty())
+      {
+        add(std::filesystem::u8path(line));
+      }
+    }
+  }
+}// namespace studio::resources
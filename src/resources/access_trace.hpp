@@ -0,0 +1,39 @@
+#ifndef DARKSTARDTSCONVERTER_ACCESS_TRACE_HPP
+#define DARKSTARDTSCONVERTER_ACCESS_TRACE_HPP
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <unordered_set>
+#include "archive_plugin.hpp"
+
+namespace studio::resources
+{
+  // The order files are first loaded in, such as while a mission loads, so that archives can be laid out to match.
+  class access_trace
+  {
+  public:
+    void record(const file_info& info);
+
+    // Full paths of the files loaded, each one only once.
+    std::vector<std::filesystem::path> get_paths() const;
+
+    // The names of the entries loaded from one archive, in the order they were first loaded.
+    std::vector<std::string> get_filenames(const std::filesystem::path& archive_path) const;
+
+    // Traces are kept as text, one path to a line.
+    void save(const std::filesystem::path& trace_path) const;
+
+    void load(const std::filesystem::path& trace_path);
+
+  private:
+    void add(std::filesystem::path path);
+
+    mutable std::mutex mutex;
+    std::vector<std::filesystem::path> paths;
+    std::unordered_set<std::string> seen;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_ACCESS_TRACE_HPP
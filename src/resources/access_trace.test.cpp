@@ -0,0 +1,37 @@
+#include <catch2/catch.hpp>
+#include "access_trace.hpp"
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Access traces record the files loaded, in the order they were first loaded", "[resources.explorer]")
+{
+  temp_folder folder("3space-trace-test");
+  auto volume_path = folder.path / "shapes.vol";
+
+  write_darkstar_vol(volume_path, { { "larmor.dts", "shape data" }, { "tribes.ppl", "palette" }, { "harmor.dts", "more shape data" } });
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  auto trace = std::make_shared<studio::resources::access_trace>();
+  explorer.set_access_trace(trace);
+
+  auto files = explorer.find_files({ "ALL" });
+  REQUIRE(files.size() == 3);
+  REQUIRE(trace->get_paths().empty());
+
+  explorer.load_file(files[2]);
+  explorer.stream_file(files[0]);
+  explorer.load_file(files[2]);
+
+  REQUIRE(trace->get_filenames(volume_path) == std::vector<std::string>{ "harmor.dts", "larmor.dts" });
+
+  trace->save(folder.path / "trace.txt");
+
+  studio::resources::access_trace loaded;
+  loaded.load(folder.path / "trace.txt");
+  REQUIRE(loaded.get_paths() == trace->get_paths());
+}
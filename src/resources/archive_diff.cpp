@@ -0,0 +1,150 @@
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <execution>
+#include "archive_diff.hpp"
+#include "xxhash64.hpp"
+
+namespace studio::resources
+{
+  // Files are hashed a chunk at a time, each chunk seeded with the hash so far, so that large files do not have to be held in memory.
+  // The chunks are the same whichever way a file is read, so the hashes of both sides can be compared.
+  constexpr auto hash_chunk_size = std::size_t(1024 * 1024);
+
+  std::uint64_t hash_file(const resource_explorer& explorer, const file_info& info)
+  {
+    std::uint64_t result = 0;
+
+    if (auto view = explorer.get_file_view(info); view.has_value())
+    {
+      for (std::size_t offset = 0; offset < view->size(); offset += hash_chunk_size)
+      {
+        result = xxhash64(view->subspan(offset, std::min(hash_chunk_size, view->size() - offset)), result);
+      }
+
+      return result;
+    }
+
+    auto [loaded_info, stream] = explorer.stream_file(info);
+    std::vector<std::byte> buffer(std::min<std::size_t>(hash_chunk_size, std::max<std::size_t>(info.size, 1)));
+    std::uint64_t total = 0;
+
+    while (total < info.size)
+    {
+      stream->read(buffer.data(), std::streamsize(buffer.size()));
+      const auto count = std::size_t(std::max<std::streamsize>(stream->gcount(), 0));
+
+      if (count == 0)
+      {
+        break;
+      }
+
+      result = xxhash64(nonstd::span<const std::byte>(buffer.data(), count), result);
+      total += count;
+    }
+
+    if (total != info.size)
+    {
+      throw std::invalid_argument("Only " + std::to_string(total) + " of " + std::to_string(info.size) + " bytes could be read.");
+    }
+
+    return result;
+  }
+
+  archive_diff diff_files(const diff_source& before, const diff_source& after)
+  {
+    struct file_pair
+    {
+      const file_info* before = nullptr;
+      const file_info* after = nullptr;
+      std::filesystem::path path;
+    };
+
+    std::map<std::string, file_pair> pairs;
+
+    auto add_files = [&](const diff_source& source, const file_info* file_pair::*side) {
+      for (auto& info : source.files)
+      {
+        auto path = (info.folder_path / info.filename).lexically_relative(source.base);
+        auto& pair = pairs[normalise_path(path)];
+        pair.*side = &info;
+
+        if (pair.path.empty())
+        {
+          pair.path = std::move(path);
+        }
+      }
+    };
+
+    add_files(before, &file_pair::before);
+    add_files(after, &file_pair::after);
+
+    archive_diff result{};
+    std::vector<file_pair*> same_size;
+
+    for (auto& [key, pair] : pairs)
+    {
+      if (pair.before && pair.after && pair.before->size == pair.after->size)
+      {
+        same_size.emplace_back(&pair);
+      }
+    }
+
+    // Only files whose contents differ end up in here, so it rarely needs the lock for long.
+    std::mutex result_mutex;
+    std::vector<const file_pair*> changed;
+    std::atomic<std::uint64_t> hashed_bytes = 0;
+
+    std::for_each(std::execution::par, same_size.begin(), same_size.end(), [&](const file_pair* pair) {
+      // Exceptions cannot leave a parallel algorithm without terminating, so they are reported afterwards.
+      try
+      {
+        const auto are_equal = hash_file(before.explorer, *pair->before) == hash_file(after.explorer, *pair->after);
+        hashed_bytes += pair->before->size + pair->after->size;
+
+        if (!are_equal)
+        {
+          std::lock_guard<std::mutex> lock(result_mutex);
+          changed.emplace_back(pair);
+        }
+      }
+      catch (const std::exception& ex)
+      {
+        std::lock_guard<std::mutex> lock(result_mutex);
+        result.errors.emplace_back(pair->path.string() + ": " + ex.what());
+      }
+    });
+
+    result.hashed_files = same_size.size();
+    result.hashed_bytes = hashed_bytes;
+    result.unchanged_files = same_size.size() - changed.size() - result.errors.size();
+
+    std::sort(changed.begin(), changed.end());
+
+    for (auto& [key, pair] : pairs)
+    {
+      auto add_entry = [&](diff_status status) {
+        result.entries.emplace_back(diff_entry{ status,
+          pair.path,
+          pair.before ? std::optional<file_info>(*pair.before) : std::nullopt,
+          pair.after ? std::optional<file_info>(*pair.after) : std::nullopt });
+      };
+
+      if (!pair.before)
+      {
+        add_entry(diff_status::added);
+      }
+      else if (!pair.after)
+      {
+        add_entry(diff_status::removed);
+      }
+      else if (pair.before->size != pair.after->size || std::binary_search(changed.begin(), changed.end(), &pair))
+      {
+        add_entry(diff_status::changed);
+      }
+    }
+
+    return result;
+  }
+}// namespace studio::resources
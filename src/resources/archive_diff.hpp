@@ -0,0 +1,54 @@
+#ifndef DARKSTARDTSCONVERTER_ARCHIVE_DIFF_HPP
+#define DARKSTARDTSCONVERTER_ARCHIVE_DIFF_HPP
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <filesystem>
+#include "resource_explorer.hpp"
+
+namespace studio::resources
+{
+  enum class diff_status
+  {
+    added,
+    removed,
+    changed
+  };
+
+  // One side of a comparison. Files are matched up by their path relative to base, without regard to case,
+  // so base is the root of a game install, or the archive itself when comparing two archives.
+  struct diff_source
+  {
+    const resource_explorer& explorer;
+    std::filesystem::path base;
+    std::vector<file_info> files;
+  };
+
+  struct diff_entry
+  {
+    diff_status status;
+    std::filesystem::path path;
+    std::optional<file_info> before;
+    std::optional<file_info> after;
+  };
+
+  struct archive_diff
+  {
+    // Sorted by path.
+    std::vector<diff_entry> entries;
+    std::size_t unchanged_files;
+    // Files only need to be hashed when they are the same size on both sides.
+    std::size_t hashed_files;
+    std::uint64_t hashed_bytes;
+    std::vector<std::string> errors;
+  };
+
+  // Hashes the contents of a file straight from its archive, without extracting it.
+  std::uint64_t hash_file(const resource_explorer& explorer, const file_info& info);
+
+  // Compares two sets of files. Files of the same size are hashed in parallel to tell whether they have changed.
+  archive_diff diff_files(const diff_source& before, const diff_source& after);
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_ARCHIVE_DIFF_HPP
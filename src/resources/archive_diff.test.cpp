@@ -0,0 +1,49 @@
+#include <catch2/catch.hpp>
+#include "archive_diff.hpp"
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Two installs are compared entry by entry without extracting anything", "[resources.archive_diff]")
+{
+  temp_folder folder("3space-diff-test");
+  std::filesystem::create_directories(folder.path / "before");
+  std::filesystem::create_directories(folder.path / "after");
+
+  write_darkstar_vol(folder.path / "before" / "shapes.vol", { { "larmor.dts", "shape data" }, { "harmor.dts", "heavy armor" }, { "old.dts", "gone" }, { "tribes.ppl", "pppppppppppppppppppppppppppppppppalette", studio::resources::compression_type::lz } });
+  write_darkstar_vol(folder.path / "after" / "shapes.vol", { { "LARMOR.DTS", "shape data" }, { "harmor.dts", "heavy armour" }, { "new.dts", "added" }, { "tribes.ppl", "pppppppppppppppppppppppppppppppppalettf", studio::resources::compression_type::lzh } });
+  std::ofstream(folder.path / "after" / "readme.txt") << "patch notes";
+
+  const auto before_path = folder.path / "before";
+  const auto after_path = folder.path / "after";
+
+  studio::resources::resource_explorer before_explorer(before_path);
+  before_explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+  studio::resources::resource_explorer after_explorer(after_path);
+  after_explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  auto diff = studio::resources::diff_files({ before_explorer, before_path, before_explorer.find_files({ "ALL" }) },
+    { after_explorer, after_path, after_explorer.find_files({ "ALL" }) });
+
+  REQUIRE(diff.errors.empty());
+  REQUIRE(diff.hashed_files == 2);
+  REQUIRE(diff.unchanged_files == 1);
+
+  std::vector<std::pair<studio::resources::diff_status, std::string>> results;
+
+  for (auto& entry : diff.entries)
+  {
+    results.emplace_back(entry.status, entry.path.generic_string());
+  }
+
+  REQUIRE(results == std::vector<std::pair<studio::resources::diff_status, std::string>>{
+            { studio::resources::diff_status::added, "readme.txt" },
+            { studio::resources::diff_status::changed, "shapes.vol/harmor.dts" },
+            { studio::resources::diff_status::added, "shapes.vol/new.dts" },
+            { studio::resources::diff_status::removed, "shapes.vol/old.dts" },
+            { studio::resources::diff_status::changed, "shapes.vol/tribes.ppl" } });
+
+  REQUIRE(studio::resources::hash_file(before_explorer, diff.entries[4].before.value()) != studio::resources::hash_file(after_explorer, diff.entries[4].after.value()));
+}
@@ -0,0 +1,40 @@
+#include <sstream>
+#include "archive_plugin.hpp"
+#include "range_stream.hpp"
+
+namespace studio::resources
+{
+  std::size_t archive_plugin::read_entry(const positional_file& source, const file_info& info, std::uint64_t offset, nonstd::span<std::byte> output) const
+  {
+    if (offset >= info.size)
+    {
+      return 0;
+    }
+
+    const auto count = std::size_t(std::min<std::uint64_t>(output.size(), info.size - offset));
+
+    // The stream is only used by this call, so the plugin can seek it however it likes.
+    range_stream stream(source);
+
+    if (info.compression_type == compression_type::none)
+    {
+      set_stream_position(stream, info);
+      const auto position = stream.tellg();
+
+      if (!stream || position < 0)
+      {
+        return 0;
+      }
+
+      return source.read(std::uint64_t(position) + offset, output.first(count));
+    }
+
+    std::basic_stringstream<std::byte> contents;
+    extract_file_contents(stream, info, contents);
+
+    contents.seekg(std::streamoff(offset), std::ios::beg);
+    contents.read(output.data(), std::streamsize(count));
+
+    return std::size_t(std::max<std::streamsize>(contents.gcount(), 0));
+  }
+}// namespace studio::resources
@@ -4,10 +4,14 @@
 #include <istream>
 #include <ostream>
 #include <string>
+#include <algorithm>
+#include <memory>
 #include <optional>
 #include <variant>
 #include <filesystem>
+#include <nonstd/span.hpp>
 #include "../shared.hpp"
+#include "positional_file.hpp"
 
 namespace studio::resources
 {
@@ -19,6 +23,8 @@ namespace studio::resources
     lzh
   };
 
+  using stream_validator = bool(std::basic_istream<std::byte>&);
+
   struct file_info
   {
     std::filesystem::path filename;
@@ -26,6 +32,10 @@ namespace studio::resources
     std::size_t size;
     compression_type compression_type;
     std::filesystem::path folder_path;
+    // The check which recognised the contents of the file, once its format has been detected.
+    stream_validator* format = nullptr;
+    // The checksum stored for the entry by the archive, for formats which keep one.
+    std::optional<std::uint32_t> checksum;
   };
 
   struct folder_info
@@ -35,6 +45,16 @@ namespace studio::resources
     std::filesystem::path full_path;
   };
 
+  // Entry paths are compared without regard to case, the same way the games look them up.
+  inline std::string normalise_path(const std::filesystem::path& path)
+  {
+    auto result = path.generic_u8string();
+    std::transform(result.begin(), result.end(), result.begin(), [](char c) { return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c; });
+    return result;
+  }
+
+  class decompression_index;
+
   struct archive_plugin
   {
     using folder_info = studio::resources::folder_info;
@@ -49,6 +69,23 @@ namespace studio::resources
 
     virtual void extract_file_contents(std::basic_istream<std::byte>&, const file_info&, std::basic_ostream<std::byte>&) const = 0;
 
+    // Reads the entry from offset bytes into it, until output is full or the entry ends, and returns how many bytes were read.
+    // source is the file named by get_data_path. No position is shared between calls, so threads can read the same source at once.
+    virtual std::size_t read_entry(const positional_file& source, const file_info& info, std::uint64_t offset, nonstd::span<std::byte> output) const;
+
+    // Opens a stream which decompresses a compressed entry as it is read, recording checkpoints in index so that it can seek cheaply.
+    // Formats which do not know where the compressed data of an entry is return nullptr, and are decompressed in full instead.
+    virtual std::unique_ptr<std::basic_istream<std::byte>> open_compressed_entry(std::unique_ptr<std::basic_istream<std::byte>>, const file_info&, std::shared_ptr<decompression_index>) const
+    {
+      return nullptr;
+    }
+
+    // The file which holds the data of an entry, for archives which keep their data outside of the archive file itself.
+    virtual std::filesystem::path get_data_path(const std::filesystem::path& archive_path, const file_info&) const
+    {
+      return archive_path;
+    }
+
     virtual ~archive_plugin() = default;
     archive_plugin() = default;
     archive_plugin(const archive_plugin&) = delete;
@@ -0,0 +1,128 @@
+#include <array>
+#include <algorithm>
+#include <mutex>
+#include <string_view>
+#include <atomic>
+#include <execution>
+#include "archive_verifier.hpp"
+#include "block_copy.hpp"
+#include "crc32.hpp"
+
+namespace studio::resources
+{
+  namespace
+  {
+    // Archive types whose checksums are known to be the CRC-32 of the contents, having been checked against files from the games.
+    // None have been so far, so a mismatch in any of them is reported as unconfirmed rather than invalid.
+    constexpr std::array<std::string_view, 0> confirmed_archive_types{};
+
+    bool has_confirmed_checksum(const file_info& info)
+    {
+      const auto extension = normalise_path(resource_explorer::get_archive_path(info.folder_path).extension());
+
+      return std::any_of(confirmed_archive_types.begin(), confirmed_archive_types.end(), [&](auto type) { return type == extension; });
+    }
+  }// namespace
+
+  std::uint32_t get_file_checksum(const resource_explorer& explorer, const file_info& info)
+  {
+    if (auto view = explorer.get_file_view(info); view.has_value())
+    {
+      return crc32(view.value());
+    }
+
+    auto [loaded_info, stream] = explorer.load_file(info);
+
+    std::vector<std::byte> buffer(std::min(info.size, copy_block_size));
+    std::uint32_t result = 0;
+    auto remaining = info.size;
+
+    while (remaining > 0 && *stream)
+    {
+      stream->read(buffer.data(), std::streamsize(std::min(remaining, buffer.size())));
+      const auto count = std::size_t(stream->gcount());
+
+      if (count == 0)
+      {
+        break;
+      }
+
+      result = crc32(nonstd::span<const std::byte>(buffer.data(), count), result);
+      remaining -= count;
+    }
+
+    if (remaining > 0)
+    {
+      throw std::invalid_argument("The entry is shorter than its listed size.");
+    }
+
+    return result;
+  }
+
+  verification_result verify_file(const resource_explorer& explorer, const file_info& info)
+  {
+    verification_result result{ info, checksum_status::unchecked, 0 };
+
+    if (!info.checksum.has_value())
+    {
+      return result;
+    }
+
+    try
+    {
+      result.actual_checksum = get_file_checksum(explorer, info);
+      if (result.actual_checksum == info.checksum.value())
+      {
+        result.status = checksum_status::valid;
+      }
+      else
+      {
+        result.status = has_confirmed_checksum(info) ? checksum_status::invalid : checksum_status::unconfirmed;
+      }
+    }
+    catch (const std::exception&)
+    {
+      result.status = checksum_status::unreadable;
+    }
+
+    return result;
+  }
+
+  verification_summary verify_files(const resource_explorer& explorer, const std::vector<file_info>& files)
+  {
+    std::array<std::atomic<std::size_t>, 5> counts{};
+    std::atomic<std::uint64_t> checked_bytes = 0;
+
+    std::mutex failure_mutex;
+    std::vector<verification_result> failures;
+
+    std::for_each(std::execution::par, files.begin(), files.end(), [&](const auto& info) {
+      auto result = verify_file(explorer, info);
+      counts[std::size_t(result.status)]++;
+
+      if (result.status == checksum_status::unchecked)
+      {
+        return;
+      }
+
+      checked_bytes += info.size;
+
+      if (result.status == checksum_status::invalid || result.status == checksum_status::unreadable)
+      {
+        std::lock_guard<std::mutex> lock(failure_mutex);
+        failures.emplace_back(std::move(result));
+      }
+    });
+
+    verification_summary summary{};
+    summary.valid_files = counts[std::size_t(checksum_status::valid)];
+    summary.invalid_files = counts[std::size_t(checksum_status::invalid)];
+    summary.unreadable_files = counts[std::size_t(checksum_status::unreadable)];
+    summary.unchecked_files = counts[std::size_t(checksum_status::unchecked)];
+    summary.unconfirmed_files = counts[std::size_t(checksum_status::unconfirmed)];
+    summary.checked_bytes = checked_bytes;
+    summary.failures = std::move(failures);
+
+    return summary;
+  }
+}// namespace studio::resources
@@ -0,0 +1,50 @@
+#ifndef DARKSTARDTSCONVERTER_ARCHIVE_VERIFIER_HPP
+#define DARKSTARDTSCONVERTER_ARCHIVE_VERIFIER_HPP
+
+#include <vector>
+#include <cstdint>
+#include "resource_explorer.hpp"
+
+namespace studio::resources
+{
+  enum class checksum_status
+  {
+    valid,
+    invalid,
+    unreadable,
+    // The archive stores no checksum for the entry.
+    unchecked,
+    // The checksum did not match, but how this archive type computes its checksums has not been confirmed,
+    // so the mismatch may be down to the algorithm rather than the entry.
+    unconfirmed
+  };
+
+  struct verification_result
+  {
+    file_info info;
+    checksum_status status;
+    std::uint32_t actual_checksum;
+  };
+
+  struct verification_summary
+  {
+    std::size_t valid_files;
+    std::size_t invalid_files;
+    std::size_t unreadable_files;
+    std::size_t unchecked_files;
+    std::size_t unconfirmed_files;
+    std::uint64_t checked_bytes;
+    // Every entry which was invalid or unreadable, in no particular order.
+    std::vector<verification_result> failures;
+  };
+
+  // The CRC-32 of the contents of an entry, after decompression.
+  std::uint32_t get_file_checksum(const resource_explorer& explorer, const file_info& info);
+
+  verification_result verify_file(const resource_explorer& explorer, const file_info& info);
+
+  // Checks the entries of any number of archives against their stored checksums, several entries at a time.
+  verification_summary verify_files(const resource_explorer& explorer, const std::vector<file_info>& files);
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_ARCHIVE_VERIFIER_HPP
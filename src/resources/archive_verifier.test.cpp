@@ -0,0 +1,137 @@
+#include <catch2/catch.hpp>
+#include <fstream>
+#include <string_view>
+#include "crc32.hpp"
+#include "archive_verifier.hpp"
+#include "block_copy.hpp"
+#include "trophy_bass_volume.hpp"
+#include "default_resource_explorer.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Archive entries are verified against their stored checksums", "[resources.archive_verifier]")
+{
+  temp_folder folder("3space-verify-test");
+
+  constexpr std::string_view good = "good data";
+  constexpr std::string_view bad = "damaged data";
+
+  {
+    std::basic_ofstream<std::byte> output(folder.path / "test.tbv", std::ios::binary);
+    write_string(output, "TBVolume", 9);
+    write_uint(output, 0, 2);
+    write_uint(output, 2, 2);
+    write_uint(output, 0, 4);
+    write_string(output, "RichRayl@CUC", 12);
+    write_string(output, "", 12);
+
+    const auto first_offset = 9 + 32 + 2 * 8;
+    write_uint(output, studio::resources::crc32(to_bytes(good)), 4);
+    write_uint(output, first_offset, 4);
+    write_uint(output, studio::resources::crc32(to_bytes("original data")), 4);
+    write_uint(output, std::uint32_t(first_offset + 28 + good.size()), 4);
+
+    write_string(output, "good.dat", 24);
+    write_uint(output, std::uint32_t(good.size()), 4);
+    write_string(output, good, good.size());
+    write_string(output, "bad.dat", 24);
+    write_uint(output, std::uint32_t(bad.size()), 4);
+    write_string(output, bad, bad.size());
+  }
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".tbv", std::make_unique<studio::resources::vol::trophy_bass::tbv_file_archive>());
+
+  auto files = explorer.find_files({ "ALL" });
+  REQUIRE(files.size() == 2);
+
+  std::ofstream(folder.path / "loose.txt") << "no checksum";
+  files.emplace_back(explorer.find_files({ ".txt" }).at(0));
+
+  auto summary = studio::resources::verify_files(explorer, files);
+
+  REQUIRE(summary.valid_files == 1);
+  REQUIRE(summary.unreadable_files == 0);
+  REQUIRE(summary.unchecked_files == 1);
+  REQUIRE(summary.checked_bytes == good.size() + bad.size());
+
+  // The TBV checksum is only assumed to be CRC-32, so a mismatch does not make the entry invalid.
+  REQUIRE(summary.invalid_files == 0);
+  REQUIRE(summary.unconfirmed_files == 1);
+  REQUIRE(summary.failures.empty());
+
+  auto result = studio::resources::verify_file(explorer, files[1]);
+  REQUIRE(result.info.filename == "bad.dat");
+  REQUIRE(result.status == studio::resources::checksum_status::unconfirmed);
+  REQUIRE(result.actual_checksum == studio::resources::crc32(to_bytes(bad)));
+
+}
+
+TEST_CASE("Entries without a mapped view are checksummed from a stream", "[resources.archive_verifier]")
+{
+  temp_folder folder("3space-stream-checksum-test");
+
+  // Larger than one block, so that the checksum is carried over from one read to the next.
+  std::string contents(studio::resources::copy_block_size * 2 + 100, '\0');
+
+  for (auto i = 0u; i < contents.size(); ++i)
+  {
+    contents[i] = char('a' + i % 26);
+  }
+
+  std::ofstream(folder.path / "loose.txt", std::ios::binary) << contents;
+
+  studio::resources::resource_explorer explorer(folder.path);
+  auto info = explorer.find_files({ ".txt" }).at(0);
+  REQUIRE_FALSE(explorer.get_file_view(info).has_value());
+
+  REQUIRE(studio::resources::get_file_checksum(explorer, info) == studio::resources::crc32(to_bytes(contents)));
+
+  info.checksum = studio::resources::crc32(to_bytes(contents));
+  REQUIRE(studio::resources::verify_file(explorer, info).status == studio::resources::checksum_status::valid);
+
+  info.size += 10;
+  REQUIRE(studio::resources::verify_file(explorer, info).status == studio::resources::checksum_status::unreadable);
+
+}
+
+TEST_CASE("DYN entries are listed, read and verified by the default explorer", "[resources.archive_verifier]")
+{
+  temp_folder folder("3space-dyn-test");
+
+  constexpr std::string_view first = "first entry!";
+  constexpr std::string_view second = "second";
+
+  {
+    std::basic_ofstream<std::byte> output(folder.path / "test.dyn", std::ios::binary);
+    write_string(output, "Dynamix Volume File", 20);
+    write_string(output, "", 12);
+    write_uint(output, 2, 4);
+    write_uint(output, studio::resources::crc32(to_bytes(first)), 4);
+    write_uint(output, studio::resources::crc32(to_bytes(second)), 4);
+
+    // Each entry starts on a four byte boundary, so the first one is followed by three bytes of padding.
+    write_string(output, "first.dat", 13);
+    write_uint(output, std::uint32_t(first.size()), 4);
+    write_string(output, first, first.size() + 3);
+    write_string(output, "second.dat", 13);
+    write_uint(output, std::uint32_t(second.size()), 4);
+    write_string(output, second, second.size());
+  }
+
+  auto explorer = studio::resources::create_default_resource_explorer(folder.path);
+  auto files = explorer.find_files({ "ALL" });
+  REQUIRE(files.size() == 2);
+  REQUIRE(files[1].filename == "second.dat");
+
+  auto [info, stream] = explorer.load_file(files[1]);
+  std::string contents(second.size(), '\0');
+  stream->read(reinterpret_cast<std::byte*>(contents.data()), std::streamsize(contents.size()));
+  REQUIRE(contents == second);
+
+  auto summary = studio::resources::verify_files(explorer, files);
+  REQUIRE(summary.valid_files == 2);
+  REQUIRE(summary.failures.empty());
+
+}
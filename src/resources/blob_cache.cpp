@@ -0,0 +1,112 @@
+#include "blob_cache.hpp"
+
+namespace studio::resources
+{
+  blob_buffer::blob_buffer(blob& output) : output(output)
+  {
+  }
+
+  blob_buffer::int_type blob_buffer::overflow(int_type value)
+  {
+    if (traits_type::eq_int_type(value, traits_type::eof()))
+    {
+      return traits_type::not_eof(value);
+    }
+
+    output.emplace_back(traits_type::to_char_type(value));
+    return value;
+  }
+
+  std::streamsize blob_buffer::xsputn(const char_type* values, std::streamsize count)
+  {
+    output.insert(output.end(), values, values + count);
+    return count;
+  }
+
+  blob_stream::blob_stream(blob& output) : std::basic_ostream<std::byte>(nullptr), buffer(output)
+  {
+    rdbuf(&buffer);
+  }
+
+  blob_cache::blob_cache(std::size_t capacity_in_bytes) : capacity(capacity_in_bytes)
+  {
+  }
+
+  std::shared_ptr<const blob> blob_cache::find(const std::string& key)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto existing = lookup.find(key);
+
+    if (existing == lookup.end())
+    {
+      misses++;
+      return nullptr;
+    }
+
+    hits++;
+    entries.splice(entries.begin(), entries, existing->second);
+    return existing->second->second;
+  }
+
+  void blob_cache::insert(const std::string& key, std::shared_ptr<const blob> value)
+  {
+    if (!value)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (value->size() > capacity)
+    {
+      return;
+    }
+
+    if (auto existing = lookup.find(key); existing != lookup.end())
+    {
+      size -= existing->second->second->size();
+      entries.erase(existing->second);
+      lookup.erase(existing);
+    }
+
+    evict(capacity - value->size());
+
+    size += value->size();
+    entries.emplace_front(key, std::move(value));
+    lookup.emplace(key, entries.begin());
+  }
+
+  void blob_cache::set_capacity(std::size_t capacity_in_bytes)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = capacity_in_bytes;
+    evict(capacity);
+  }
+
+  void blob_cache::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    lookup.clear();
+    size = 0;
+  }
+
+  blob_cache_stats blob_cache::get_stats() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return blob_cache_stats{ hits, misses, evictions, entries.size(), size, capacity };
+  }
+
+  void blob_cache::evict(std::size_t capacity_in_bytes)
+  {
+    while (size > capacity_in_bytes && !entries.empty())
+    {
+      auto& oldest = entries.back();
+      size -= oldest.second->size();
+      lookup.erase(oldest.first);
+      entries.pop_back();
+      evictions++;
+    }
+  }
+}// namespace studio::resources
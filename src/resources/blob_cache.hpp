@@ -0,0 +1,89 @@
+#ifndef DARKSTARDTSCONVERTER_BLOB_CACHE_HPP
+#define DARKSTARDTSCONVERTER_BLOB_CACHE_HPP
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <ostream>
+#include <vector>
+#include <cstddef>
+#include <unordered_map>
+
+namespace studio::resources
+{
+  using blob = std::vector<std::byte>;
+
+  // Appends everything written to it to the end of a blob.
+  class blob_buffer : public std::basic_streambuf<std::byte>
+  {
+  public:
+    explicit blob_buffer(blob& output);
+
+  protected:
+    int_type overflow(int_type value) override;
+    std::streamsize xsputn(const char_type* values, std::streamsize count) override;
+
+  private:
+    blob& output;
+  };
+
+  // An output stream which writes straight into a blob, rather than into a string which has to be copied out afterwards.
+  class blob_stream : public std::basic_ostream<std::byte>
+  {
+  public:
+    explicit blob_stream(blob& output);
+
+  private:
+    blob_buffer buffer;
+  };
+
+  struct blob_cache_stats
+  {
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t evictions;
+    std::size_t entry_count;
+    std::size_t size_in_bytes;
+    std::size_t capacity_in_bytes;
+  };
+
+  // Decompressed archive entries, kept until the cache grows past its byte budget,
+  // at which point the least recently used entries are dropped.
+  // Blobs handed out stay valid after they are evicted, for as long as someone holds on to them.
+  class blob_cache
+  {
+  public:
+    static constexpr std::size_t default_capacity = 64 * 1024 * 1024;
+
+    explicit blob_cache(std::size_t capacity_in_bytes = default_capacity);
+
+    std::shared_ptr<const blob> find(const std::string& key);
+
+    // Blobs larger than the whole budget are not kept.
+    void insert(const std::string& key, std::shared_ptr<const blob> value);
+
+    void set_capacity(std::size_t capacity_in_bytes);
+
+    void clear();
+
+    blob_cache_stats get_stats() const;
+
+  private:
+    using entry = std::pair<std::string, std::shared_ptr<const blob>>;
+
+    void evict(std::size_t capacity_in_bytes);
+
+    mutable std::mutex mutex;
+    std::size_t capacity;
+    std::size_t size = 0;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+
+    std::list<entry> entries;
+    std::unordered_map<std::string, std::list<entry>::iterator> lookup;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_BLOB_CACHE_HPP
@@ -0,0 +1,47 @@
+#include <catch2/catch.hpp>
+#include "blob_cache.hpp"
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Decompressed entries are served from the blob cache", "[resources.blob_cache]")
+{
+  temp_folder folder("3space-blob-test");
+  auto volume_path = folder.path / "shapes.vol";
+
+  write_darkstar_vol(volume_path, { { "larmor.dts", "aaaaaaaaaaaaaaaabbbbbbbbbbbbbbbbshape", studio::resources::compression_type::rle },
+                                    { "tribes.ppl", "pppppppppppppppppppppppppppppppppalette", studio::resources::compression_type::rle } });
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  auto files = explorer.find_files({ "ALL" });
+  REQUIRE(files.size() == 2);
+  REQUIRE(files[0].compression_type == studio::resources::compression_type::rle);
+
+  auto load = [&](const auto& info) {
+    auto [loaded_info, stream] = explorer.load_file(info);
+    return to_string(*stream);
+  };
+
+  REQUIRE(load(files[0]) == "aaaaaaaaaaaaaaaabbbbbbbbbbbbbbbbshape");
+  REQUIRE(load(files[0]) == "aaaaaaaaaaaaaaaabbbbbbbbbbbbbbbbshape");
+
+  auto stats = explorer.get_blob_cache()->get_stats();
+  REQUIRE(stats.misses == 1);
+  REQUIRE(stats.hits == 1);
+  REQUIRE(stats.size_in_bytes == files[0].size);
+
+  explorer.get_blob_cache()->set_capacity(files[1].size);
+
+  REQUIRE(load(files[1]) == "pppppppppppppppppppppppppppppppppalette");
+  REQUIRE(load(files[0]) == "aaaaaaaaaaaaaaaabbbbbbbbbbbbbbbbshape");
+
+  stats = explorer.get_blob_cache()->get_stats();
+  REQUIRE(stats.misses == 3);
+  REQUIRE(stats.evictions == 2);
+  REQUIRE(stats.entry_count == 1);
+  REQUIRE(stats.size_in_bytes == files[0].size);
+}
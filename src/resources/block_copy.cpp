@@ -0,0 +1,111 @@
+#include <cerrno>
+#include <vector>
+#include <algorithm>
+#include "block_copy.hpp"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/sendfile.h>
+#endif
+
+namespace studio::resources
+{
+  std::size_t copy_bytes(std::basic_istream<std::byte>& input, std::basic_ostream<std::byte>& output, std::size_t count)
+  {
+    std::vector<std::byte> buffer(std::min(count, copy_block_size));
+    std::size_t total = 0;
+
+    while (total < count)
+    {
+      input.read(buffer.data(), std::streamsize(std::min(count - total, buffer.size())));
+      const auto bytes_read = input.gcount();
+
+      if (bytes_read <= 0)
+      {
+        break;
+      }
+
+      output.write(buffer.data(), bytes_read);
+      total += std::size_t(bytes_read);
+    }
+
+    return total;
+  }
+
+#ifdef __linux__
+  namespace
+  {
+    struct file_descriptor
+    {
+      int value;
+
+      ~file_descriptor()
+      {
+        if (value != -1)
+        {
+          close(value);
+        }
+      }
+    };
+
+    std::int64_t copy_range(int input, off_t& offset, int output, std::uint64_t size)
+    {
+      auto result = copy_file_range(input, &offset, output, nullptr, size, 0);
+
+      // Older kernels and some file systems cannot copy between these files, but can still send between them.
+      if (result == -1 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP))
+      {
+        result = sendfile(output, input, &offset, size);
+      }
+
+      return result;
+    }
+  }
+
+  bool copy_file_region(const std::filesystem::path& source, std::uint64_t offset, std::uint64_t size, const std::filesystem::path& destination)
+  {
+    file_descriptor input{ open(source.c_str(), O_RDONLY | O_CLOEXEC) };
+
+    if (input.value == -1)
+    {
+      return false;
+    }
+
+    file_descriptor output{ open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) };
+
+    if (output.value == -1)
+    {
+      return false;
+    }
+
+    auto input_offset = off_t(offset);
+    auto remaining = size;
+
+    while (remaining > 0)
+    {
+      const auto result = copy_range(input.value, input_offset, output.value, remaining);
+
+      if (result == -1 && errno == EINTR)
+      {
+        continue;
+      }
+
+      // Running out of source before size bytes leaves a short file, which the caller has to hear about.
+      if (result <= 0)
+      {
+        return false;
+      }
+
+      remaining -= std::uint64_t(result);
+    }
+
+    return true;
+  }
+#else
+  bool copy_file_region(const std::filesystem::path&, std::uint64_t, std::uint64_t, const std::filesystem::path&)
+  {
+    return false;
+  }
+#endif
+}// namespace studio::resources
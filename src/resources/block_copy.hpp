@@ -0,0 +1,22 @@
+#ifndef DARKSTARDTSCONVERTER_BLOCK_COPY_HPP
+#define DARKSTARDTSCONVERTER_BLOCK_COPY_HPP
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <filesystem>
+
+namespace studio::resources
+{
+  constexpr std::size_t copy_block_size = 1024 * 1024;
+
+  // Copies up to count bytes from the current position of input, a block at a time rather than a byte at a time.
+  // Returns how many bytes were copied, which is less than count when input ends early.
+  std::size_t copy_bytes(std::basic_istream<std::byte>& input, std::basic_ostream<std::byte>& output, std::size_t count);
+
+  // Writes size bytes from offset in source into a new file at destination, letting the kernel do the copy where it can.
+  // Returns false when that is not supported here, or source ends before size bytes, in which case the caller should copy the bytes itself.
+  bool copy_file_region(const std::filesystem::path& source, std::uint64_t offset, std::uint64_t size, const std::filesystem::path& destination);
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_BLOCK_COPY_HPP
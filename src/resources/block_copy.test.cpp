@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include "block_copy.hpp"
+#include "mapped_file.hpp"
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Entries are extracted a block at a time", "[resources.block_copy]")
+{
+  temp_folder folder("3space-extract-test");
+  auto volume_path = folder.path / "shapes.vol";
+  auto destination = folder.path / "out";
+
+  const std::string large_contents(3 * studio::resources::copy_block_size / 2, 'x');
+
+  write_darkstar_vol(volume_path, { { "larmor.dts", large_contents }, { "tribes.ppl", "pppppppppppppppppppppppppppppppppalette", studio::resources::compression_type::rle } });
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  auto files = explorer.find_files({ "ALL" });
+  REQUIRE(files.size() == 2);
+
+  std::basic_ifstream<std::byte> archive_file(volume_path, std::ios::binary);
+
+  for (auto& file : files)
+  {
+    explorer.extract_file_contents(archive_file, destination, file);
+  }
+
+  std::basic_ifstream<std::byte> shape(destination / "shapes" / "larmor.dts", std::ios::binary);
+  REQUIRE(to_string(shape) == large_contents);
+
+  std::basic_ifstream<std::byte> palette(destination / "shapes" / "tribes.ppl", std::ios::binary);
+  REQUIRE(to_string(palette) == "pppppppppppppppppppppppppppppppppalette");
+
+  studio::resources::span_stream input(nonstd::span<const std::byte>(reinterpret_cast<const std::byte*>(large_contents.data()), 10));
+  std::basic_stringstream<std::byte> output;
+  REQUIRE(studio::resources::copy_bytes(input, output, 20) == 10);
+}
+
+#ifdef __linux__
+TEST_CASE("A region which runs past the end of its file is not copied in full", "[resources.block_copy]")
+{
+  temp_folder folder("3space-region-test");
+  auto source = folder.path / "source.bin";
+
+  {
+    std::ofstream output(source, std::ios::binary);
+    output << "0123456789";
+  }
+
+  REQUIRE(studio::resources::copy_file_region(source, 2, 8, folder.path / "whole.bin"));
+  REQUIRE(std::filesystem::file_size(folder.path / "whole.bin") == 8);
+
+  REQUIRE(!studio::resources::copy_file_region(source, 2, 20, folder.path / "short.bin"));
+  REQUIRE(!studio::resources::copy_file_region(source, 20, 4, folder.path / "past.bin"));
+}
+#endif
@@ -0,0 +1,1104 @@
+#include <array>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "compression.hpp"
+
+namespace studio::resources
+{
+  constexpr auto lz_window_size = 4096u;
+  constexpr auto lz_window_mask = lz_window_size - 1;
+  constexpr auto lz_max_match = 18u;
+  constexpr auto lz_threshold = 2u;
+  constexpr auto lz_max_distance = lz_window_size - lz_max_match;
+  constexpr auto lz_max_chain_depth = 32;
+
+  constexpr auto chunk_size = std::size_t(64 * 1024);
+
+  struct chunked_input
+  {
+    std::basic_istream<std::byte>& stream;
+    std::size_t remaining;
+    std::vector<std::byte> buffer = std::vector<std::byte>(chunk_size);
+    std::size_t position = 0;
+    std::size_t available = 0;
+    // How far into the compressed data the buffer starts.
+    std::size_t start = 0;
+
+    bool refill()
+    {
+      start += available;
+      available = 0;
+      position = 0;
+
+      if (remaining == 0)
+      {
+        return false;
+      }
+
+      stream.read(buffer.data(), std::streamsize(std::min(remaining, buffer.size())));
+      available = std::size_t(stream.gcount());
+
+      if (stream.eof())
+      {
+        // Reading past the end of an entry is expected when the compressed size is unknown,
+        // so the stream is left usable for the next entry.
+        stream.clear();
+        remaining = available;
+      }
+
+      remaining -= available;
+
+      return available != 0;
+    }
+
+    bool next(std::byte& value)
+    {
+      if (position == available && !refill())
+      {
+        return false;
+      }
+
+      value = buffer[position++];
+      return true;
+    }
+
+    std::size_t consumed() const
+    {
+      return start + position;
+    }
+  };
+
+  // Decoders keep everything they need to carry on in their state, so that they can stop after any number of bytes
+  // and be copied into a checkpoint at that point. Matches which do not fit in the output are finished by the next call.
+  struct lz_state
+  {
+    std::array<std::byte, lz_window_size> window = make_window();
+    unsigned window_position = lz_window_size - lz_max_match;
+    unsigned flags = 0;
+    unsigned match_position = 0;
+    std::size_t match_remaining = 0;
+
+    static std::array<std::byte, lz_window_size> make_window()
+    {
+      std::array<std::byte, lz_window_size> result{};
+      result.fill(std::byte{ ' ' });
+      return result;
+    }
+
+    std::size_t copy_match(std::byte* output, std::size_t count)
+    {
+      const auto length = std::min(match_remaining, count);
+
+      for (auto i = 0u; i < length; ++i)
+      {
+        const auto value = window[match_position++ & lz_window_mask];
+        output[i] = value;
+        window[window_position++ & lz_window_mask] = value;
+      }
+
+      match_remaining -= length;
+      return length;
+    }
+
+    std::size_t decode(chunked_input& reader, std::byte* output, std::size_t count)
+    {
+      std::size_t written = copy_match(output, count);
+
+      while (written < count)
+      {
+        if (((flags >>= 1) & 0x100) == 0)
+        {
+          std::byte value{};
+
+          if (!reader.next(value))
+          {
+            break;
+          }
+
+          flags = std::to_integer<unsigned>(value) | 0xff00;
+        }
+
+        if (flags & 1)
+        {
+          std::byte value{};
+
+          if (!reader.next(value))
+          {
+            break;
+          }
+
+          output[written++] = value;
+          window[window_position++ & lz_window_mask] = value;
+        }
+        else
+        {
+          std::byte low{};
+          std::byte high{};
+
+          if (!reader.next(low) || !reader.next(high))
+          {
+            break;
+          }
+
+          match_position = std::to_integer<unsigned>(low) | ((std::to_integer<unsigned>(high) & 0xf0) << 4);
+          match_remaining = (std::to_integer<unsigned>(high) & 0x0f) + lz_threshold + 1;
+          written += copy_match(output + written, count - written);
+        }
+      }
+
+      return written;
+    }
+  };
+
+  struct lz_match_finder
+  {
+    constexpr static auto hash_bits = 12u;
+
+    nonstd::span<const std::byte> input;
+    std::size_t max_match;
+    std::size_t max_distance;
+    std::vector<std::int32_t> head = std::vector<std::int32_t>(1u << hash_bits, -1);
+    std::vector<std::int32_t> previous = std::vector<std::int32_t>(input.size(), -1);
+
+    std::uint32_t hash_at(std::size_t index) const
+    {
+      const auto value = std::to_integer<std::uint32_t>(input[index]) << 16 | std::to_integer<std::uint32_t>(input[index + 1]) << 8 | std::to_integer<std::uint32_t>(input[index + 2]);
+      return (value * 2654435761u) >> (32 - hash_bits);
+    }
+
+    void insert(std::size_t index)
+    {
+      if (index + 3 <= input.size())
+      {
+        auto& bucket = head[hash_at(index)];
+        previous[index] = bucket;
+        bucket = std::int32_t(index);
+      }
+    }
+
+    // Returns the length and source index of the longest match found for the data at index.
+    std::pair<std::size_t, std::size_t> find(std::size_t index) const
+    {
+      std::size_t best_length = 0;
+      std::size_t best_position = 0;
+
+      if (index + 3 > input.size())
+      {
+        return std::make_pair(best_length, best_position);
+      }
+
+      const auto max_length = std::min<std::size_t>(max_match, input.size() - index);
+      auto candidate = head[hash_at(index)];
+
+      for (auto depth = 0; candidate >= 0 && index - candidate <= max_distance && depth < lz_max_chain_depth; ++depth)
+      {
+        std::size_t length = 0;
+
+        while (length < max_length && input[candidate + length] == input[index + length])
+        {
+          length++;
+        }
+
+        if (length > best_length)
+        {
+          best_length = length;
+          best_position = std::size_t(candidate);
+
+          if (length == max_length)
+          {
+            break;
+          }
+        }
+
+        candidate = previous[candidate];
+      }
+
+      return std::make_pair(best_length, best_position);
+    }
+  };
+
+  std::vector<std::byte> compress_lz(nonstd::span<const std::byte> input)
+  {
+    std::vector<std::byte> results;
+    results.reserve(input.size() + input.size() / 8 + 1);
+
+    lz_match_finder finder{ input, lz_max_match, lz_max_distance };
+
+    std::size_t flag_position = 0;
+    auto flag_bit = 8u;
+
+    auto add_flag = [&](bool is_literal) {
+      if (flag_bit == 8)
+      {
+        flag_position = results.size();
+        results.emplace_back(std::byte{ 0 });
+        flag_bit = 0;
+      }
+
+      if (is_literal)
+      {
+        results[flag_position] |= std::byte(1u << flag_bit);
+      }
+
+      flag_bit++;
+    };
+
+    std::size_t index = 0;
+
+    while (index < input.size())
+    {
+      const auto [best_length, best_position] = finder.find(index);
+
+      if (best_length > lz_threshold)
+      {
+        add_flag(false);
+
+        // Positions are absolute offsets into the decoder's ring buffer.
+        const auto window_position = (lz_window_size - lz_max_match + best_position) & lz_window_mask;
+        results.emplace_back(std::byte(window_position & 0xff));
+        results.emplace_back(std::byte(((window_position >> 4) & 0xf0) | (best_length - lz_threshold - 1)));
+
+        for (auto i = 0u; i < best_length; ++i)
+        {
+          finder.insert(index + i);
+        }
+
+        index += best_length;
+      }
+      else
+      {
+        add_flag(true);
+        results.emplace_back(input[index]);
+        finder.insert(index);
+        index++;
+      }
+    }
+
+    return results;
+  }
+
+  constexpr auto lzh_max_match = 60u;
+  constexpr auto lzh_max_distance = lz_window_size - lzh_max_match;
+  constexpr auto lzh_char_count = 256 - lz_threshold + lzh_max_match;
+  constexpr auto lzh_table_size = lzh_char_count * 2 - 1;
+  constexpr auto lzh_root = lzh_table_size - 1;
+  constexpr auto lzh_max_frequency = 0x8000u;
+
+  // Code lengths for the upper 6 bits of a match position. The codes themselves are assigned in order,
+  // which lets the decoder resolve a position with a single 8 bit table lookup.
+  constexpr std::array<std::uint8_t, 6> lzh_position_length_counts = { 1, 3, 8, 12, 24, 16 };
+
+  struct lzh_position_tables
+  {
+    std::array<std::uint8_t, 64> encode_code{};
+    std::array<std::uint8_t, 64> encode_length{};
+    std::array<std::uint8_t, 256> decode_code{};
+    std::array<std::uint8_t, 256> decode_length{};
+  };
+
+  constexpr lzh_position_tables make_lzh_position_tables()
+  {
+    lzh_position_tables tables{};
+
+    auto index = 0u;
+    auto code = 0u;
+
+    for (auto i = 0u; i < lzh_position_length_counts.size(); ++i)
+    {
+      const auto length = i + 3;
+
+      for (auto count = 0u; count < lzh_position_length_counts[i]; ++count, ++index)
+      {
+        tables.encode_code[index] = std::uint8_t(code);
+        tables.encode_length[index] = std::uint8_t(length);
+
+        for (auto x = 0u; x < (0x100u >> length); ++x)
+        {
+          tables.decode_code[code + x] = std::uint8_t(index);
+          tables.decode_length[code + x] = std::uint8_t(length);
+        }
+
+        code += 0x100u >> length;
+      }
+    }
+
+    return tables;
+  }
+
+  constexpr auto lzh_tables = make_lzh_position_tables();
+
+  static_assert(lzh_tables.decode_code[0xff] == 63 && lzh_tables.decode_length[0x00] == 3);
+
+  // Adaptive Huffman tree shared by the encoder and decoder, as used by LZHUF.
+  // Sibling nodes always occupy an even/odd pair of slots, so a node's branch bit is the low bit of its index.
+  struct lzh_tree
+  {
+    std::array<std::uint16_t, lzh_table_size + 1> frequency{};
+    std::array<std::int16_t, lzh_table_size + lzh_char_count> parent{};
+    std::array<std::int16_t, lzh_table_size> child{};
+
+    lzh_tree()
+    {
+      for (auto i = 0u; i < lzh_char_count; ++i)
+      {
+        frequency[i] = 1;
+        child[i] = std::int16_t(i + lzh_table_size);
+        parent[i + lzh_table_size] = std::int16_t(i);
+      }
+
+      for (auto i = 0u, j = lzh_char_count; j <= lzh_root; i += 2, ++j)
+      {
+        frequency[j] = frequency[i] + frequency[i + 1];
+        child[j] = std::int16_t(i);
+        parent[i] = parent[i + 1] = std::int16_t(j);
+      }
+
+      frequency[lzh_table_size] = 0xffff;
+      parent[lzh_root] = 0;
+    }
+
+    void rebuild()
+    {
+      auto j = 0u;
+
+      for (auto i = 0u; i < lzh_table_size; ++i)
+      {
+        if (child[i] >= std::int16_t(lzh_table_size))
+        {
+          frequency[j] = std::uint16_t((frequency[i] + 1) / 2);
+          child[j] = child[i];
+          j++;
+        }
+      }
+
+      for (auto i = 0u, j = lzh_char_count; j < lzh_table_size; i += 2, ++j)
+      {
+        const auto new_frequency = std::uint16_t(frequency[i] + frequency[i + 1]);
+        frequency[j] = new_frequency;
+
+        auto k = j - 1;
+
+        while (new_frequency < frequency[k])
+        {
+          k--;
+        }
+
+        k++;
+
+        std::copy_backward(frequency.begin() + k, frequency.begin() + j, frequency.begin() + j + 1);
+        frequency[k] = new_frequency;
+        std::copy_backward(child.begin() + k, child.begin() + j, child.begin() + j + 1);
+        child[k] = std::int16_t(i);
+      }
+
+      for (auto i = 0u; i < lzh_table_size; ++i)
+      {
+        if (auto k = child[i]; k >= std::int16_t(lzh_table_size))
+        {
+          parent[k] = std::int16_t(i);
+        }
+        else
+        {
+          parent[k] = parent[k + 1] = std::int16_t(i);
+        }
+      }
+    }
+
+    void update(unsigned symbol)
+    {
+      if (frequency[lzh_root] == lzh_max_frequency)
+      {
+        rebuild();
+      }
+
+      auto node = unsigned(parent[symbol + lzh_table_size]);
+
+      do
+      {
+        const auto new_frequency = ++frequency[node];
+
+        if (auto other = node + 1; new_frequency > frequency[other])
+        {
+          while (new_frequency > frequency[++other])
+          {
+          }
+
+          other--;
+          frequency[node] = frequency[other];
+          frequency[other] = new_frequency;
+
+          const auto node_child = child[node];
+          parent[node_child] = std::int16_t(other);
+
+          if (node_child < std::int16_t(lzh_table_size))
+          {
+            parent[node_child + 1] = std::int16_t(other);
+          }
+
+          const auto other_child = child[other];
+          child[other] = node_child;
+
+          parent[other_child] = std::int16_t(node);
+
+          if (other_child < std::int16_t(lzh_table_size))
+          {
+            parent[other_child + 1] = std::int16_t(node);
+          }
+
+          child[node] = other_child;
+          node = other;
+        }
+
+        node = unsigned(parent[node]);
+      } while (node != 0);
+    }
+  };
+
+  // MSB-first bit reader which tops up its 64 bit buffer with whole bytes, using a single load when 8 bytes are buffered.
+  struct lzh_bit_reader
+  {
+    chunked_input& reader;
+    std::uint64_t& bits;
+    unsigned& count;
+
+    void refill()
+    {
+      const auto free_bytes = (64 - count) / 8;
+
+      if (free_bytes == 0)
+      {
+        return;
+      }
+
+      if (reader.position + sizeof(std::uint64_t) <= reader.available)
+      {
+        std::uint64_t value = 0;
+
+        for (auto i = 0u; i < sizeof(value); ++i)
+        {
+          value = value << 8 | std::to_integer<std::uint64_t>(reader.buffer[reader.position + i]);
+        }
+
+        bits |= (value >> (64 - free_bytes * 8)) << (64 - count - free_bytes * 8);
+        reader.position += free_bytes;
+        count += free_bytes * 8;
+        return;
+      }
+
+      for (auto i = 0u; i < free_bytes; ++i)
+      {
+        std::byte value{};
+
+        if (!reader.next(value))
+        {
+          // Past the end of the data, zero bits are returned, just like the original decoder.
+          count = 64;
+          return;
+        }
+
+        bits |= std::to_integer<std::uint64_t>(value) << (56 - count);
+        count += 8;
+      }
+    }
+
+    unsigned get_bits(unsigned bit_count)
+    {
+      if (count < bit_count)
+      {
+        refill();
+      }
+
+      const auto result = unsigned(bits >> (64 - bit_count));
+      bits <<= bit_count;
+      count -= bit_count;
+      return result;
+    }
+  };
+
+  struct lzh_state
+  {
+    lzh_tree tree;
+    std::array<std::byte, lz_window_size> window = lz_state::make_window();
+    unsigned window_position = lz_window_size - lzh_max_match;
+    std::uint64_t bits = 0;
+    unsigned bit_count = 0;
+    unsigned match_position = 0;
+    std::size_t match_remaining = 0;
+
+    std::size_t copy_match(std::byte* output, std::size_t count)
+    {
+      const auto length = std::min(match_remaining, count);
+
+      for (auto i = 0u; i < length; ++i)
+      {
+        const auto value = window[match_position++ & lz_window_mask];
+        output[i] = value;
+        window[window_position++ & lz_window_mask] = value;
+      }
+
+      match_remaining -= length;
+      return length;
+    }
+
+    std::size_t decode(chunked_input& reader, std::byte* output, std::size_t count)
+    {
+      lzh_bit_reader bit_reader{ reader, bits, bit_count };
+      std::size_t written = copy_match(output, count);
+
+      while (written < count)
+      {
+        auto node = unsigned(tree.child[lzh_root]);
+
+        while (node < lzh_table_size)
+        {
+          node = unsigned(tree.child[node + bit_reader.get_bits(1)]);
+        }
+
+        const auto symbol = node - lzh_table_size;
+        tree.update(symbol);
+
+        if (symbol < 256)
+        {
+          const auto value = std::byte(symbol);
+          output[written++] = value;
+          window[window_position++ & lz_window_mask] = value;
+          continue;
+        }
+
+        auto position_bits = bit_reader.get_bits(8);
+        const auto upper_bits = unsigned(lzh_tables.decode_code[position_bits]) << 6;
+        const auto extra_bits = lzh_tables.decode_length[position_bits] - 2u;
+
+        position_bits = (position_bits << extra_bits) | bit_reader.get_bits(extra_bits);
+
+        match_position = window_position - (upper_bits | (position_bits & 0x3f)) - 1;
+        match_remaining = symbol - 255 + lz_threshold;
+        written += copy_match(output + written, count - written);
+      }
+
+      return written;
+    }
+  };
+
+  std::vector<std::byte> compress_lzh(nonstd::span<const std::byte> input)
+  {
+    std::vector<std::byte> results;
+    results.reserve(input.size() / 2 + 16);
+
+    lz_match_finder finder{ input, lzh_max_match, lzh_max_distance };
+    lzh_tree tree;
+
+    std::uint32_t pending_bits = 0;
+    auto pending_count = 0u;
+
+    auto put_bits = [&](std::uint64_t value, unsigned bit_count) {
+      while (bit_count > 0)
+      {
+        const auto to_take = std::min(bit_count, 8u);
+        bit_count -= to_take;
+        pending_bits = (pending_bits << to_take) | std::uint32_t((value >> bit_count) & ((1u << to_take) - 1));
+        pending_count += to_take;
+
+        while (pending_count >= 8)
+        {
+          pending_count -= 8;
+          results.emplace_back(std::byte((pending_bits >> pending_count) & 0xff));
+        }
+      }
+    };
+
+    auto put_symbol = [&](unsigned symbol) {
+      std::uint64_t code = 0;
+      auto length = 0u;
+
+      for (auto node = unsigned(tree.parent[symbol + lzh_table_size]); node != lzh_root; node = unsigned(tree.parent[node]))
+      {
+        code |= std::uint64_t(node & 1) << length;
+        length++;
+      }
+
+      put_bits(code, length);
+      tree.update(symbol);
+    };
+
+    std::size_t index = 0;
+
+    while (index < input.size())
+    {
+      const auto [best_length, best_position] = finder.find(index);
+
+      if (best_length > lz_threshold)
+      {
+        put_symbol(unsigned(best_length + 255 - lz_threshold));
+
+        const auto position = unsigned(index - best_position - 1);
+        const auto upper_bits = position >> 6;
+        put_bits(lzh_tables.encode_code[upper_bits] >> (8 - lzh_tables.encode_length[upper_bits]), lzh_tables.encode_length[upper_bits]);
+        put_bits(position & 0x3f, 6);
+
+        for (auto i = 0u; i < best_length; ++i)
+        {
+          finder.insert(index + i);
+        }
+
+        index += best_length;
+      }
+      else
+      {
+        put_symbol(std::to_integer<unsigned>(input[index]));
+        finder.insert(index);
+        index++;
+      }
+    }
+
+    if (pending_count > 0)
+    {
+      put_bits(0, 8 - pending_count);
+    }
+
+    return results;
+  }
+
+  struct rle_state
+  {
+    std::size_t literal_remaining = 0;
+    std::size_t run_remaining = 0;
+    std::byte run_value{};
+
+    std::size_t decode(chunked_input& reader, std::byte* output, std::size_t count)
+    {
+      std::size_t written = 0;
+
+      while (written < count)
+      {
+        if (run_remaining > 0)
+        {
+          const auto length = std::min(run_remaining, count - written);
+          std::memset(output + written, std::to_integer<int>(run_value), length);
+          run_remaining -= length;
+          written += length;
+          continue;
+        }
+
+        if (literal_remaining > 0)
+        {
+          if (reader.position == reader.available && !reader.refill())
+          {
+            // The original decoder stops at the end of the data, so a truncated literal run ends the output too.
+            return written;
+          }
+
+          const auto length = std::min({ literal_remaining, count - written, reader.available - reader.position });
+          std::memcpy(output + written, reader.buffer.data() + reader.position, length);
+          reader.position += length;
+          literal_remaining -= length;
+          written += length;
+          continue;
+        }
+
+        std::byte control{};
+
+        if (!reader.next(control))
+        {
+          break;
+        }
+
+        const auto value = std::to_integer<int>(control);
+
+        if (value < 0x80)
+        {
+          literal_remaining = std::size_t(value) + 1;
+        }
+        else if (value > 0x80)
+        {
+          if (!reader.next(run_value))
+          {
+            break;
+          }
+
+          run_remaining = std::size_t(0x101 - value);
+        }
+      }
+
+      return written;
+    }
+  };
+
+  struct copy_state
+  {
+    std::size_t decode(chunked_input& reader, std::byte* output, std::size_t count)
+    {
+      std::size_t written = 0;
+
+      while (written < count && (reader.position < reader.available || reader.refill()))
+      {
+        const auto length = std::min(count - written, reader.available - reader.position);
+        std::memcpy(output + written, reader.buffer.data() + reader.position, length);
+        reader.position += length;
+        written += length;
+      }
+
+      return written;
+    }
+  };
+
+  struct resumable_decoder
+  {
+    chunked_input reader;
+
+    resumable_decoder(std::basic_istream<std::byte>& input, std::size_t compressed_size) : reader{ input, compressed_size }
+    {
+    }
+
+    virtual ~resumable_decoder() = default;
+
+    // Fills output unless the compressed data runs out first, and returns how many bytes were written.
+    virtual std::size_t decode(std::byte* output, std::size_t count) = 0;
+    virtual std::shared_ptr<const void> save() const = 0;
+    virtual void restore(const void* state) = 0;
+  };
+
+  template<typename State>
+  struct basic_decoder final : resumable_decoder
+  {
+    using resumable_decoder::resumable_decoder;
+
+    State state;
+
+    std::size_t decode(std::byte* output, std::size_t count) override
+    {
+      return state.decode(reader, output, count);
+    }
+
+    std::shared_ptr<const void> save() const override
+    {
+      return std::make_shared<const State>(state);
+    }
+
+    void restore(const void* saved) override
+    {
+      state = *static_cast<const State*>(saved);
+    }
+  };
+
+  std::unique_ptr<resumable_decoder> make_decoder(compression_type type, std::basic_istream<std::byte>& input, std::size_t compressed_size)
+  {
+    switch (type)
+    {
+    case compression_type::none:
+      return std::make_unique<basic_decoder<copy_state>>(input, compressed_size);
+    case compression_type::rle:
+      return std::make_unique<basic_decoder<rle_state>>(input, compressed_size);
+    case compression_type::lz:
+      return std::make_unique<basic_decoder<lz_state>>(input, compressed_size);
+    case compression_type::lzh:
+      return std::make_unique<basic_decoder<lzh_state>>(input, compressed_size);
+    default:
+      throw std::invalid_argument("The compression type of the file is not supported.");
+    }
+  }
+
+  template<typename State>
+  void decompress_all(std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::basic_ostream<std::byte>& output)
+  {
+    chunked_input reader{ input, compressed_size };
+    State state;
+    std::vector<std::byte> buffer(std::min(chunk_size, uncompressed_size));
+    std::size_t written = 0;
+
+    while (written < uncompressed_size)
+    {
+      const auto wanted = std::min(buffer.size(), uncompressed_size - written);
+      const auto count = state.decode(reader, buffer.data(), wanted);
+      output.write(buffer.data(), std::streamsize(count));
+      written += count;
+
+      if (count < wanted)
+      {
+        break;
+      }
+    }
+  }
+
+  void decompress_lz(std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::basic_ostream<std::byte>& output)
+  {
+    decompress_all<lz_state>(input, compressed_size, uncompressed_size, output);
+  }
+
+  void decompress_lzh(std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::basic_ostream<std::byte>& output)
+  {
+    decompress_all<lzh_state>(input, compressed_size, uncompressed_size, output);
+  }
+
+  void decompress_rle(std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::basic_ostream<std::byte>& output)
+  {
+    decompress_all<rle_state>(input, compressed_size, uncompressed_size, output);
+  }
+
+  std::vector<std::byte> compress_rle(nonstd::span<const std::byte> input)
+  {
+    constexpr auto max_run = 128u;
+
+    std::vector<std::byte> results;
+    results.reserve(input.size() + input.size() / max_run + 1);
+
+    std::size_t index = 0;
+    std::size_t literal_start = 0;
+
+    auto add_literals = [&](std::size_t end) {
+      while (literal_start < end)
+      {
+        const auto count = std::min<std::size_t>(end - literal_start, max_run);
+        results.emplace_back(std::byte(count - 1));
+        results.insert(results.end(), input.begin() + literal_start, input.begin() + literal_start + count);
+        literal_start += count;
+      }
+    };
+
+    while (index < input.size())
+    {
+      auto run_end = index + 1;
+
+      while (run_end < input.size() && run_end - index < max_run && input[run_end] == input[index])
+      {
+        run_end++;
+      }
+
+      if (run_end - index >= 3)
+      {
+        add_literals(index);
+        results.emplace_back(std::byte(0x101 - (run_end - index)));
+        results.emplace_back(input[index]);
+        literal_start = index = run_end;
+      }
+      else
+      {
+        index = run_end;
+      }
+    }
+
+    add_literals(input.size());
+
+    return results;
+  }
+
+  void decompress(compression_type type, std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::basic_ostream<std::byte>& output)
+  {
+    switch (type)
+    {
+    case compression_type::none:
+    {
+      chunked_input reader{ input, std::min(compressed_size, uncompressed_size) };
+
+      while (reader.refill())
+      {
+        output.write(reader.buffer.data(), std::streamsize(reader.available));
+      }
+      return;
+    }
+    case compression_type::rle:
+      decompress_rle(input, compressed_size, uncompressed_size, output);
+      return;
+    case compression_type::lz:
+      decompress_lz(input, compressed_size, uncompressed_size, output);
+      return;
+    case compression_type::lzh:
+      decompress_lzh(input, compressed_size, uncompressed_size, output);
+      return;
+    default:
+      throw std::invalid_argument("The compression type of the file is not supported.");
+    }
+  }
+
+  decompression_index::decompression_index(std::size_t interval) : interval(std::max<std::size_t>(interval, 1))
+  {
+  }
+
+  std::size_t decompression_index::get_interval() const
+  {
+    return interval;
+  }
+
+  std::optional<decompression_checkpoint> decompression_index::find(std::size_t uncompressed_offset) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto next = checkpoints.upper_bound(uncompressed_offset);
+
+    if (next == checkpoints.begin())
+    {
+      return std::nullopt;
+    }
+
+    return std::prev(next)->second;
+  }
+
+  void decompression_index::add(decompression_checkpoint checkpoint)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    checkpoints.emplace(checkpoint.uncompressed_offset, std::move(checkpoint));
+  }
+
+  std::size_t decompression_index::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return checkpoints.size();
+  }
+
+  constexpr auto decompressing_buffer_size = std::size_t(16 * 1024);
+
+  decompressing_buffer::decompressing_buffer(compression_type type, std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::shared_ptr<decompression_index> index)
+    : input(input),
+      input_start(input.tellg()),
+      compressed_size(compressed_size),
+      uncompressed_size(uncompressed_size),
+      index(index ? std::move(index) : std::make_shared<decompression_index>()),
+      decoder(make_decoder(type, input, compressed_size)),
+      buffer(decompressing_buffer_size)
+  {
+    if (!this->index->find(0).has_value())
+    {
+      this->index->add(decompression_checkpoint{ 0, 0, decoder->save() });
+    }
+  }
+
+  decompressing_buffer::~decompressing_buffer() = default;
+
+  std::size_t decompressing_buffer::get_position() const
+  {
+    return decoded - std::size_t(egptr() - gptr());
+  }
+
+  bool decompressing_buffer::decode_block()
+  {
+    // Blocks end on checkpoint boundaries, so that checkpoints are always taken at the same offsets.
+    const auto interval = index->get_interval();
+    const auto next_checkpoint = (decoded / interval + 1) * interval;
+    const auto wanted = std::min({ buffer.size(), next_checkpoint - decoded, uncompressed_size - decoded });
+
+    if (wanted == 0)
+    {
+      setg(nullptr, nullptr, nullptr);
+      return false;
+    }
+
+    const auto count = decoder->decode(buffer.data(), wanted);
+    decoded += count;
+    setg(buffer.data(), buffer.data(), buffer.data() + count);
+
+    if (count == wanted && decoded == next_checkpoint && decoded < uncompressed_size)
+    {
+      index->add(decompression_checkpoint{ decoder->reader.consumed(), decoded, decoder->save() });
+    }
+
+    return count != 0;
+  }
+
+  void decompressing_buffer::restore(const decompression_checkpoint& checkpoint)
+  {
+    input.clear();
+    input.seekg(input_start + std::streamoff(checkpoint.compressed_offset), std::ios::beg);
+
+    auto& reader = decoder->reader;
+    reader.remaining = compressed_size == unknown_compressed_size ? unknown_compressed_size : compressed_size - std::min(compressed_size, checkpoint.compressed_offset);
+    reader.start = checkpoint.compressed_offset;
+    reader.position = 0;
+    reader.available = 0;
+
+    decoder->restore(checkpoint.state.get());
+    decoded = checkpoint.uncompressed_offset;
+    setg(nullptr, nullptr, nullptr);
+  }
+
+  decompressing_buffer::int_type decompressing_buffer::underflow()
+  {
+    if (gptr() < egptr())
+    {
+      return traits_type::to_int_type(*gptr());
+    }
+
+    if (!decode_block())
+    {
+      return traits_type::eof();
+    }
+
+    return traits_type::to_int_type(*gptr());
+  }
+
+  decompressing_buffer::pos_type decompressing_buffer::seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode)
+  {
+    if (!(mode & std::ios_base::in))
+    {
+      return pos_type(off_type(-1));
+    }
+
+    off_type base = 0;
+
+    if (direction == std::ios_base::cur)
+    {
+      base = off_type(get_position());
+    }
+    else if (direction == std::ios_base::end)
+    {
+      base = off_type(uncompressed_size);
+    }
+
+    const auto new_offset = base + offset;
+
+    if (new_offset < 0 || std::size_t(new_offset) > uncompressed_size)
+    {
+      return pos_type(off_type(-1));
+    }
+
+    const auto target = std::size_t(new_offset);
+    const auto buffer_start = decoded - std::size_t(egptr() - eback());
+
+    if (eback() != nullptr && target >= buffer_start && target <= decoded)
+    {
+      setg(eback(), eback() + (target - buffer_start), egptr());
+      return pos_type(new_offset);
+    }
+
+    // Decoding carries on from where it is, unless a checkpoint gets closer to the target.
+    if (auto checkpoint = index->find(target); checkpoint.has_value() && (target < decoded || checkpoint->uncompressed_offset > decoded))
+    {
+      restore(checkpoint.value());
+    }
+
+    setg(nullptr, nullptr, nullptr);
+
+    while (decoded < target)
+    {
+      if (!decode_block())
+      {
+        return pos_type(off_type(-1));
+      }
+    }
+
+    if (eback() != nullptr)
+    {
+      setg(eback(), egptr() - (decoded - target), egptr());
+    }
+
+    return pos_type(new_offset);
+  }
+
+  decompressing_buffer::pos_type decompressing_buffer::seekpos(pos_type position, std::ios_base::openmode mode)
+  {
+    return seekoff(off_type(position), std::ios_base::beg, mode);
+  }
+
+  std::streamsize decompressing_buffer::showmanyc()
+  {
+    const auto remaining = uncompressed_size - std::min(get_position(), uncompressed_size);
+    return remaining == 0 ? -1 : std::streamsize(remaining);
+  }
+
+  decompressing_stream::decompressing_stream(std::unique_ptr<std::basic_istream<std::byte>> input, compression_type type, std::size_t compressed_size, std::size_t uncompressed_size, std::shared_ptr<decompression_index> index)
+    : std::basic_istream<std::byte>(nullptr), input(std::move(input)), buffer(type, *this->input, compressed_size, uncompressed_size, std::move(index))
+  {
+    rdbuf(&buffer);
+  }
+}// namespace studio::resources
@@ -0,0 +1,117 @@
+#ifndef DARKSTARDTSCONVERTER_COMPRESSION_HPP
+#define DARKSTARDTSCONVERTER_COMPRESSION_HPP
+
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <optional>
+#include <nonstd/span.hpp>
+#include "archive_plugin.hpp"
+
+namespace studio::resources
+{
+  constexpr auto unknown_compressed_size = std::numeric_limits<std::size_t>::max();
+
+  // Decodes PackBits style run-length data: a control byte below 0x80 is followed by that many literal bytes plus one,
+  // a control byte above 0x80 repeats the next byte 0x101 minus the control byte times, and 0x80 is skipped.
+  void decompress_rle(std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::basic_ostream<std::byte>& output);
+
+  std::vector<std::byte> compress_rle(nonstd::span<const std::byte> input);
+
+  // Decodes LZSS data (4 KiB ring buffer, 18 byte max match, LSB-first flag bytes)
+  // straight into the output stream. Decoding stops once uncompressed_size bytes have been written
+  // or compressed_size bytes have been consumed, whichever comes first.
+  void decompress_lz(std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::basic_ostream<std::byte>& output);
+
+  std::vector<std::byte> compress_lz(nonstd::span<const std::byte> input);
+
+  // Decodes LZSS data (4 KiB ring buffer, 60 byte max match) where literals and match lengths
+  // are coded with an adaptive Huffman tree and match positions with a fixed prefix code, as in LZHUF.
+  void decompress_lzh(std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::basic_ostream<std::byte>& output);
+
+  std::vector<std::byte> compress_lzh(nonstd::span<const std::byte> input);
+
+  void decompress(compression_type type, std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::basic_ostream<std::byte>& output);
+
+  constexpr auto default_checkpoint_interval = std::size_t(64 * 1024);
+
+  // Where a decoder was after writing uncompressed_offset bytes, so that decoding can start again from there.
+  struct decompression_checkpoint
+  {
+    std::size_t compressed_offset;
+    std::size_t uncompressed_offset;
+    // The window and any other decoder state, which only the same kind of decoder can make sense of.
+    std::shared_ptr<const void> state;
+  };
+
+  // Checkpoints taken every interval bytes while a compressed entry is decoded.
+  // One index can be shared by every stream over the same entry, from any number of threads.
+  class decompression_index
+  {
+  public:
+    explicit decompression_index(std::size_t interval = default_checkpoint_interval);
+
+    std::size_t get_interval() const;
+
+    // The last checkpoint at or before uncompressed_offset.
+    std::optional<decompression_checkpoint> find(std::size_t uncompressed_offset) const;
+
+    void add(decompression_checkpoint checkpoint);
+
+    std::size_t size() const;
+
+  private:
+    std::size_t interval;
+    mutable std::mutex mutex;
+    std::map<std::size_t, decompression_checkpoint> checkpoints;
+  };
+
+  struct resumable_decoder;
+
+  // Decompresses an entry as it is read. Seeking restarts from the closest checkpoint before the new position,
+  // so only the data after it is decoded again.
+  class decompressing_buffer : public std::basic_streambuf<std::byte>
+  {
+  public:
+    // input has to be at the start of the compressed data.
+    decompressing_buffer(compression_type type, std::basic_istream<std::byte>& input, std::size_t compressed_size, std::size_t uncompressed_size, std::shared_ptr<decompression_index> index = nullptr);
+    ~decompressing_buffer() override;
+
+  protected:
+    int_type underflow() override;
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode) override;
+    pos_type seekpos(pos_type position, std::ios_base::openmode mode) override;
+    std::streamsize showmanyc() override;
+
+  private:
+    std::size_t get_position() const;
+    bool decode_block();
+    void restore(const decompression_checkpoint& checkpoint);
+
+    std::basic_istream<std::byte>& input;
+    std::streamoff input_start;
+    std::size_t compressed_size;
+    std::size_t uncompressed_size;
+    std::shared_ptr<decompression_index> index;
+    std::unique_ptr<resumable_decoder> decoder;
+    // How many bytes the decoder has written, up to the end of the buffer.
+    std::size_t decoded = 0;
+    std::vector<std::byte> buffer;
+  };
+
+  class decompressing_stream : public std::basic_istream<std::byte>
+  {
+  public:
+    decompressing_stream(std::unique_ptr<std::basic_istream<std::byte>> input, compression_type type, std::size_t compressed_size, std::size_t uncompressed_size, std::shared_ptr<decompression_index> index = nullptr);
+
+  private:
+    std::unique_ptr<std::basic_istream<std::byte>> input;
+    decompressing_buffer buffer;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_COMPRESSION_HPP
@@ -0,0 +1,223 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <random>
+#include <string_view>
+#include "compression.hpp"
+
+namespace
+{
+  std::vector<std::byte> to_bytes(std::string_view value)
+  {
+    std::vector<std::byte> result(value.size());
+    std::transform(value.begin(), value.end(), result.begin(), [](auto c) { return std::byte(c); });
+    return result;
+  }
+
+  std::basic_stringstream<std::byte> to_stream(const std::vector<std::byte>& value)
+  {
+    std::basic_stringstream<std::byte> result;
+    result.write(value.data(), value.size());
+    return result;
+  }
+
+  std::vector<std::byte> make_corpus(std::size_t size)
+  {
+    constexpr std::string_view words[] = { "Shape", "Sequence", "Material", "Palette", "Herc", "Tank", "Flyer", "Terrain", "Mission", "Volume", " ", " ", "\r\n" };
+
+    std::mt19937 generator(1998);
+    std::uniform_int_distribution<std::size_t> distribution(0, std::size(words) - 1);
+
+    std::vector<std::byte> result;
+    result.reserve(size);
+
+    while (result.size() < size)
+    {
+      auto word = words[distribution(generator)];
+      std::transform(word.begin(), word.end(), std::back_inserter(result), [](auto c) { return std::byte(c); });
+      result.emplace_back(std::byte(generator() & 0xff));
+    }
+
+    result.resize(size);
+    return result;
+  }
+}
+
+TEST_CASE("LZ data is decoded from literals and window matches", "[compression.lz]")
+{
+  auto compressed = std::vector<std::byte>{ std::byte{ 0x07 }, std::byte{ 'a' }, std::byte{ 'b' }, std::byte{ 'c' }, std::byte{ 0xEE }, std::byte{ 0xF3 } };
+  auto input = to_stream(compressed);
+  std::basic_stringstream<std::byte> output;
+
+  studio::resources::decompress_lz(input, compressed.size(), 9, output);
+
+  REQUIRE(output.str() == std::basic_string<std::byte>(to_bytes("abcabcabc").data(), 9));
+
+  compressed = std::vector<std::byte>{ std::byte{ 0x00 }, std::byte{ 0x00 }, std::byte{ 0x00 } };
+  input = to_stream(compressed);
+  output = std::basic_stringstream<std::byte>{};
+
+  studio::resources::decompress_lz(input, compressed.size(), 3, output);
+
+  REQUIRE(output.str() == std::basic_string<std::byte>(to_bytes("   ").data(), 3));
+}
+
+TEST_CASE("LZ data round trips and stops at the uncompressed size", "[compression.lz]")
+{
+  const auto original = make_corpus(200 * 1024);
+  const auto compressed = studio::resources::compress_lz(original);
+
+  REQUIRE(compressed.size() < original.size());
+
+  auto input = to_stream(compressed);
+  input.write(original.data(), 64);
+  std::basic_stringstream<std::byte> output;
+
+  studio::resources::decompress(studio::resources::compression_type::lz, input, studio::resources::unknown_compressed_size, original.size(), output);
+
+  const auto result = output.str();
+  REQUIRE(result.size() == original.size());
+  REQUIRE(std::equal(result.begin(), result.end(), original.begin()));
+  REQUIRE(input.good());
+}
+
+TEST_CASE("LZ decoder throughput", "[compression.lz][!benchmark]")
+{
+  const auto original = make_corpus(8 * 1024 * 1024);
+  const auto compressed = studio::resources::compress_lz(original);
+
+  BENCHMARK("Decode 8 MiB of LZ data")
+  {
+    auto input = to_stream(compressed);
+    std::basic_stringstream<std::byte> output;
+    studio::resources::decompress_lz(input, compressed.size(), original.size(), output);
+    return output.tellp();
+  };
+}
+
+TEST_CASE("LZH data round trips and stops at the uncompressed size", "[compression.lzh]")
+{
+  const auto original = make_corpus(300 * 1024);
+  const auto compressed = studio::resources::compress_lzh(original);
+
+  REQUIRE(compressed.size() < original.size());
+
+  auto input = to_stream(compressed);
+  std::basic_stringstream<std::byte> output;
+
+  studio::resources::decompress(studio::resources::compression_type::lzh, input, compressed.size(), original.size(), output);
+
+  const auto result = output.str();
+  REQUIRE(result.size() == original.size());
+  REQUIRE(std::equal(result.begin(), result.end(), original.begin()));
+}
+
+TEST_CASE("LZH decoder throughput", "[compression.lzh][!benchmark]")
+{
+  const auto original = make_corpus(8 * 1024 * 1024);
+  const auto compressed = studio::resources::compress_lzh(original);
+
+  BENCHMARK("Decode 8 MiB of LZH data")
+  {
+    auto input = to_stream(compressed);
+    std::basic_stringstream<std::byte> output;
+    studio::resources::decompress_lzh(input, compressed.size(), original.size(), output);
+    return output.tellp();
+  };
+}
+
+TEST_CASE("RLE data is decoded from literal and repeated runs", "[compression.rle]")
+{
+  const auto compressed = std::vector<std::byte>{ std::byte{ 0x02 }, std::byte{ 'a' }, std::byte{ 'b' }, std::byte{ 'c' }, std::byte{ 0x80 }, std::byte{ 0xFD }, std::byte{ 'z' } };
+  auto input = to_stream(compressed);
+  std::basic_stringstream<std::byte> output;
+
+  studio::resources::decompress(studio::resources::compression_type::rle, input, compressed.size(), 7, output);
+
+  REQUIRE(output.str() == std::basic_string<std::byte>(to_bytes("abczzzz").data(), 7));
+}
+
+TEST_CASE("RLE data round trips and stops at the uncompressed size", "[compression.rle]")
+{
+  auto original = make_corpus(100 * 1024);
+  std::fill(original.begin() + 1000, original.begin() + 70000, std::byte{ 0x7f });
+
+  const auto compressed = studio::resources::compress_rle(original);
+
+  REQUIRE(compressed.size() < original.size());
+
+  auto input = to_stream(compressed);
+  std::basic_stringstream<std::byte> output;
+
+  studio::resources::decompress_rle(input, compressed.size(), original.size() - 10, output);
+
+  const auto result = output.str();
+  REQUIRE(result.size() == original.size() - 10);
+  REQUIRE(std::equal(result.begin(), result.end(), original.begin()));
+}
+
+TEST_CASE("RLE decoder throughput", "[compression.rle][!benchmark]")
+{
+  auto original = make_corpus(8 * 1024 * 1024);
+
+  for (auto i = 0u; i < original.size(); i += 4096)
+  {
+    std::fill_n(original.begin() + i, 2048, std::byte(i >> 12));
+  }
+
+  const auto compressed = studio::resources::compress_rle(original);
+
+  BENCHMARK("Decode 8 MiB of RLE data")
+  {
+    auto input = to_stream(compressed);
+    std::basic_stringstream<std::byte> output;
+    studio::resources::decompress_rle(input, compressed.size(), original.size(), output);
+    return output.tellp();
+  };
+}
+
+TEST_CASE("Compressed entries can be read from anywhere through checkpoints", "[compression.checkpoints]")
+{
+  using studio::resources::compression_type;
+
+  const auto original = make_corpus(300 * 1024);
+  constexpr auto interval = std::size_t(16 * 1024);
+
+  for (auto [type, compressed] : { std::make_pair(compression_type::rle, studio::resources::compress_rle(original)),
+         std::make_pair(compression_type::lz, studio::resources::compress_lz(original)),
+         std::make_pair(compression_type::lzh, studio::resources::compress_lzh(original)) })
+  {
+    auto index = std::make_shared<studio::resources::decompression_index>(interval);
+
+    auto read_at = [&](std::basic_istream<std::byte>& stream, std::size_t offset, std::size_t count) {
+      std::vector<std::byte> result(count);
+      stream.clear();
+      stream.seekg(std::streamoff(offset), std::ios::beg);
+      stream.read(result.data(), std::streamsize(count));
+      result.resize(std::size_t(stream.gcount()));
+      return result;
+    };
+
+    auto expected = [&](std::size_t offset, std::size_t count) {
+      return std::vector<std::byte>(original.begin() + offset, original.begin() + std::min(offset + count, original.size()));
+    };
+
+    studio::resources::decompressing_stream stream(std::make_unique<std::basic_stringstream<std::byte>>(to_stream(compressed)), type, compressed.size(), original.size(), index);
+
+    // Reading the header only decodes the first block.
+    REQUIRE(read_at(stream, 0, 64) == expected(0, 64));
+    REQUIRE(index->size() <= 2);
+
+    REQUIRE(read_at(stream, 250 * 1024 + 3, 100) == expected(250 * 1024 + 3, 100));
+    REQUIRE(read_at(stream, 20 * 1024 + 7, 40 * 1024) == expected(20 * 1024 + 7, 40 * 1024));
+    REQUIRE(read_at(stream, original.size() - 10, 100) == expected(original.size() - 10, 100));
+    REQUIRE(index->size() == original.size() / interval + 1);
+
+    // With every checkpoint known, the data before the last one is never read again.
+    auto damaged = compressed;
+    const auto last = index->find(original.size());
+    std::fill(damaged.begin(), damaged.begin() + std::ptrdiff_t(last->compressed_offset), std::byte{ 0xAA });
+
+    studio::resources::decompressing_stream resumed(std::make_unique<std::basic_stringstream<std::byte>>(to_stream(damaged)), type, damaged.size(), original.size(), index);
+    REQUIRE(read_at(resumed, last->uncompressed_offset + 5, 1000) == expected(last->uncompressed_offset + 5, 1000));
+  }
+}
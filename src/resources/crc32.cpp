@@ -0,0 +1,69 @@
+#include <array>
+#include "crc32.hpp"
+
+namespace studio::resources
+{
+  namespace
+  {
+    using crc_tables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+    constexpr crc_tables make_tables()
+    {
+      crc_tables tables{};
+
+      for (auto i = 0u; i < 256; ++i)
+      {
+        auto value = std::uint32_t(i);
+
+        for (auto bit = 0; bit < 8; ++bit)
+        {
+          value = (value >> 1) ^ (0xEDB88320u & (0u - (value & 1u)));
+        }
+
+        tables[0][i] = value;
+      }
+
+      // Table n gives the effect of a byte followed by n zero bytes, which lets eight bytes be folded in at once.
+      for (auto i = 0u; i < 256; ++i)
+      {
+        for (auto table = 1u; table < tables.size(); ++table)
+        {
+          const auto previous = tables[table - 1][i];
+          tables[table][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+        }
+      }
+
+      return tables;
+    }
+
+    constexpr auto tables = make_tables();
+
+    std::uint32_t read_uint32(const std::byte* data)
+    {
+      return std::uint32_t(data[0]) | std::uint32_t(data[1]) << 8 | std::uint32_t(data[2]) << 16 | std::uint32_t(data[3]) << 24;
+    }
+  }
+
+  std::uint32_t crc32(nonstd::span<const std::byte> data, std::uint32_t previous)
+  {
+    auto crc = ~previous;
+    auto* current = data.data();
+    auto remaining = data.size();
+
+    for (; remaining >= 8; remaining -= 8, current += 8)
+    {
+      const auto low = read_uint32(current) ^ crc;
+      const auto high = read_uint32(current + 4);
+
+      crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24]
+            ^ tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^ tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+    }
+
+    for (; remaining > 0; --remaining, ++current)
+    {
+      crc = (crc >> 8) ^ tables[0][(crc ^ std::uint32_t(*current)) & 0xFF];
+    }
+
+    return ~crc;
+  }
+}// namespace studio::resources
@@ -0,0 +1,15 @@
+#ifndef DARKSTARDTSCONVERTER_CRC32_HPP
+#define DARKSTARDTSCONVERTER_CRC32_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <nonstd/span.hpp>
+
+namespace studio::resources
+{
+  // The common CRC-32 (polynomial 0xEDB88320, as used by zip and PNG), eight bytes at a time.
+  // Pass the result of one call as previous to continue the checksum over more data.
+  std::uint32_t crc32(nonstd::span<const std::byte> data, std::uint32_t previous = 0);
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_CRC32_HPP
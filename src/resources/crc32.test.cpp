@@ -0,0 +1,54 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include "crc32.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+namespace
+{
+  std::uint32_t bitwise_crc32(nonstd::span<const std::byte> data)
+  {
+    std::uint32_t crc = 0xFFFFFFFF;
+
+    for (auto value : data)
+    {
+      crc ^= std::uint32_t(value);
+
+      for (auto bit = 0; bit < 8; ++bit)
+      {
+        crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+      }
+    }
+
+    return ~crc;
+  }
+}
+
+TEST_CASE("CRC-32 matches the reference algorithm", "[resources.crc32]")
+{
+  using studio::resources::crc32;
+
+  REQUIRE(crc32(to_bytes("")) == 0);
+  REQUIRE(crc32(to_bytes("123456789")) == 0xCBF43926);
+  REQUIRE(crc32(to_bytes("The quick brown fox jumps over the lazy dog")) == 0x414FA339);
+
+  std::vector<std::byte> data(1031);
+
+  for (auto i = 0u; i < data.size(); ++i)
+  {
+    data[i] = std::byte((i * 131) ^ (i >> 3));
+  }
+
+  auto all = nonstd::span<const std::byte>(data);
+
+  for (auto start : { 0u, 1u, 3u, 7u })
+  {
+    for (auto size : { 0u, 5u, 8u, 17u, 1000u })
+    {
+      REQUIRE(crc32(all.subspan(start, size)) == bitwise_crc32(all.subspan(start, size)));
+    }
+  }
+
+  REQUIRE(crc32(all.subspan(13)) == crc32(all.subspan(13 + 500), crc32(all.subspan(13, 500))));
+}
@@ -4,8 +4,9 @@
 #include <array>
 #include <utility>
 #include <string>
-#include <cstdlib>
 #include "resources/darkstar_volume.hpp"
+#include "resources/compression.hpp"
+#include "resources/block_copy.hpp"
 
 namespace studio::resources::vol::darkstar
 {
@@ -330,59 +331,52 @@ namespace studio::resources::vol::darkstar
     if (info.compression_type == studio::resources::compression_type::none)
     {
       set_stream_position(stream, info);
-      std::copy_n(std::istreambuf_iterator<std::byte>(stream),
-        info.size,
-        std::ostreambuf_iterator<std::byte>(output));
+      studio::resources::copy_bytes(stream, output, info.size);
     }
     else
     {
-      std::stringstream command;
+      stream.seekg(info.offset, std::ios::beg);
 
-      auto volume_filename = info.folder_path;
+      file_index_header block_header{};
+      stream.read(reinterpret_cast<std::byte*>(&block_header), sizeof(block_header));
 
-      auto folder_path = volume_filename.parent_path() / "temp";
+      // The top byte of the block size is used for flags.
+      const auto compressed_size = std::size_t(block_header.index_size & 0x00FFFFFF);
 
-      auto new_path = folder_path / (info.filename.string() + ".tmp");
-
-      std::filesystem::create_directory(folder_path);
+      studio::resources::decompress(info.compression_type, stream, compressed_size, info.size, output);
+    }
+  }
 
-      auto extract_path = std::filesystem::path("extract.exe");
+  std::size_t vol_file_archive::read_entry(const studio::resources::positional_file& source, const studio::resources::file_info& info, std::uint64_t offset, nonstd::span<std::byte> output) const
+  {
+    if (info.compression_type != studio::resources::compression_type::none)
+    {
+      return archive_plugin::read_entry(source, info, offset, output);
+    }
 
-      if (std::filesystem::exists(std::filesystem::current_path() / extract_path))
-      {
-        extract_path = std::filesystem::current_path() / extract_path;
-      }
-      else if (std::filesystem::exists(volume_filename.parent_path() / extract_path))
-      {
-        extract_path = volume_filename.parent_path() / extract_path;
-      }
+    if (offset >= info.size)
+    {
+      return 0;
+    }
 
-      auto extract_path_str = extract_path.string();
+    const auto count = std::size_t(std::min<std::uint64_t>(output.size(), info.size - offset));
+    return source.read(info.offset + sizeof(vol::darkstar::file_index_header) + offset, output.first(count));
+  }
 
-      if (extract_path_str.find(" ") != std::string::npos)
-      {
-        command << "cd /d " << extract_path.parent_path() << " && " << extract_path.filename().string()
-                << ' ' << volume_filename << ' ' << info.filename << ' ' << new_path;
-      }
-      else
-      {
-        command << extract_path.string() << ' ' << volume_filename << ' ' << info.filename << ' ' << new_path;
-      }
+  std::unique_ptr<std::basic_istream<std::byte>> vol_file_archive::open_compressed_entry(std::unique_ptr<std::basic_istream<std::byte>> stream, const studio::resources::file_info& info, std::shared_ptr<studio::resources::decompression_index> index) const
+  {
+    stream->seekg(info.offset, std::ios::beg);
 
-      std::system(command.str().c_str());
+    file_index_header block_header{};
+    stream->read(reinterpret_cast<std::byte*>(&block_header), sizeof(block_header));
 
-      if (std::filesystem::exists(new_path) && std::filesystem::file_size(new_path) > info.size)
-      {
-        {
-          auto new_file = std::basic_ifstream<std::byte>{ new_path, std::ios::binary };
+    if (!*stream)
+    {
+      return nullptr;
+    }
 
-          std::copy_n(std::istreambuf_iterator<std::byte>(new_file),
-            info.size,
-            std::ostreambuf_iterator<std::byte>(output));
-        }
+    const auto compressed_size = std::size_t(block_header.index_size & 0x00FFFFFF);
 
-        std::filesystem::remove(new_path);
-      }
-    }
+    return std::make_unique<studio::resources::decompressing_stream>(std::move(stream), info.compression_type, compressed_size, info.size, std::move(index));
   }
-}// namespace darkstar::vol
\ No newline at end of file
+}// namespace darkstar::vol
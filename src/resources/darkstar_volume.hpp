@@ -20,6 +20,8 @@ namespace studio::resources::vol::darkstar
     std::vector<content_info> get_content_listing(std::basic_istream<std::byte>& stream, std::filesystem::path archive_or_folder_path) const override;
     void set_stream_position(std::basic_istream<std::byte>& stream, const studio::resources::file_info& info) const override;
     void extract_file_contents(std::basic_istream<std::byte>& stream, const studio::resources::file_info& info, std::basic_ostream<std::byte>& output) const override;
+    std::size_t read_entry(const studio::resources::positional_file& source, const studio::resources::file_info& info, std::uint64_t offset, nonstd::span<std::byte> output) const override;
+    std::unique_ptr<std::basic_istream<std::byte>> open_compressed_entry(std::unique_ptr<std::basic_istream<std::byte>> stream, const studio::resources::file_info& info, std::shared_ptr<studio::resources::decompression_index> index) const override;
   };
 }// namespace darkstar::vol
 
@@ -0,0 +1,198 @@
+#include <array>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
+#include "resources/darkstar_volume_optimiser.hpp"
+#include "resources/darkstar_volume.hpp"
+
+namespace studio::resources::vol::darkstar
+{
+  constexpr auto block_header_size = 8u;
+
+  std::uint32_t read_block_size(std::basic_istream<std::byte>& volume, const studio::resources::file_info& info)
+  {
+    std::array<std::byte, block_header_size> header{};
+    volume.seekg(std::streamoff(info.offset), std::ios::beg);
+    volume.read(header.data(), header.size());
+
+    if (!volume)
+    {
+      throw std::invalid_argument("The block of " + info.filename.string() + " is past the end of the volume.");
+    }
+
+    std::uint32_t size = 0;
+
+    for (auto i = 0u; i < sizeof(size); ++i)
+    {
+      size |= std::to_integer<std::uint32_t>(header[4 + i]) << (i * 8);
+    }
+
+    // The top byte of the block size is used for flags.
+    return size & 0x00FFFFFF;
+  }
+
+  std::vector<volume_block> get_volume_blocks(std::basic_istream<std::byte>& volume)
+  {
+    vol_file_archive archive;
+    volume.seekg(0, std::ios::beg);
+
+    auto listing = archive.get_content_listing(volume, {});
+
+    std::vector<volume_block> results;
+    results.reserve(listing.size());
+
+    for (auto& item : listing)
+    {
+      auto& info = std::get<studio::resources::file_info>(item);
+
+      if (info.compression_type == studio::resources::compression_type::none)
+      {
+        results.emplace_back(volume_block{ info, block_header_size + info.size });
+      }
+      else
+      {
+        volume.clear();
+        results.emplace_back(volume_block{ info, block_header_size + std::uint64_t(read_block_size(volume, info)) });
+      }
+    }
+
+    volume.clear();
+    return results;
+  }
+
+  std::vector<volume_block> plan_layout(std::vector<volume_block> blocks, const optimise_options& options)
+  {
+    std::stable_sort(blocks.begin(), blocks.end(), [](const auto& a, const auto& b) {
+      return a.info.offset < b.info.offset;
+    });
+
+    if (options.order == layout_order::original)
+    {
+      return blocks;
+    }
+
+    std::unordered_map<std::string, std::size_t> trace_positions;
+
+    if (options.order == layout_order::trace)
+    {
+      for (auto& filename : options.trace)
+      {
+        trace_positions.emplace(normalise_path(filename), trace_positions.size());
+      }
+    }
+
+    auto get_key = [&](const volume_block& block) {
+      auto position = trace_positions.find(normalise_path(block.info.filename));
+      return std::make_pair(position == trace_positions.end() ? trace_positions.size() : position->second, normalise_path(block.info.filename.extension()));
+    };
+
+    std::stable_sort(blocks.begin(), blocks.end(), [&](const auto& a, const auto& b) {
+      return get_key(a) < get_key(b);
+    });
+
+    return blocks;
+  }
+
+  layout_stats measure_layout(const std::vector<volume_block>& blocks, const std::vector<std::string>& access_order, std::size_t page_size)
+  {
+    std::unordered_map<std::string, const volume_block*> blocks_by_name;
+    blocks_by_name.reserve(blocks.size());
+
+    for (auto& block : blocks)
+    {
+      blocks_by_name.emplace(normalise_path(block.info.filename), &block);
+    }
+
+    layout_stats result{};
+    std::set<std::uint64_t> pages;
+    std::optional<std::uint64_t> previous_end;
+
+    for (auto& filename : access_order)
+    {
+      auto existing = blocks_by_name.find(normalise_path(filename));
+
+      if (existing == blocks_by_name.end())
+      {
+        continue;
+      }
+
+      const auto start = std::uint64_t(existing->second->info.offset);
+      const auto end = start + existing->second->stored_size;
+
+      result.reads++;
+
+      if ((start + block_header_size) % page_size != 0)
+      {
+        result.unaligned_entries++;
+      }
+
+      for (auto page = start / page_size; page <= (end - 1) / page_size; ++page)
+      {
+        pages.emplace(page);
+      }
+
+      if (previous_end.has_value())
+      {
+        const auto previous = previous_end.value();
+
+        if (start < previous)
+        {
+          result.seeks++;
+          result.backward_seeks++;
+          result.seek_distance += previous - start;
+        }
+        else if (start - previous >= page_size)
+        {
+          result.seeks++;
+          result.seek_distance += start - previous;
+        }
+      }
+
+      previous_end = end;
+    }
+
+    result.pages_touched = pages.size();
+    return result;
+  }
+
+  vol_writer_stats optimise_volume(std::basic_istream<std::byte>& input, std::basic_ostream<std::byte>& output, const optimise_options& options)
+  {
+    vol_writer writer(studio::resources::compression_type::none, options.alignment);
+    vol_file_archive archive;
+
+    for (auto& block : plan_layout(get_volume_blocks(input), options))
+    {
+      auto filename = block.info.filename.string();
+
+      if (block.info.compression_type != studio::resources::compression_type::none && !options.decompress)
+      {
+        std::vector<std::byte> data(block.stored_size - block_header_size);
+        input.seekg(std::streamoff(block.info.offset + block_header_size), std::ios::beg);
+        input.read(data.data(), std::streamsize(data.size()));
+
+        if (!input)
+        {
+          throw std::invalid_argument("Could not read " + filename);
+        }
+
+        writer.add_compressed_file(std::move(filename), block.info.compression_type, block.info.size, std::move(data));
+        continue;
+      }
+
+      std::basic_stringstream<std::byte> contents;
+      archive.extract_file_contents(input, block.info, contents);
+
+      if (!input)
+      {
+        throw std::invalid_argument("Could not read " + filename);
+      }
+
+      auto bytes = contents.str();
+      writer.add_file(std::move(filename), std::vector<std::byte>(bytes.begin(), bytes.end()));
+    }
+
+    return writer.write(output);
+  }
+}// namespace studio::resources::vol::darkstar
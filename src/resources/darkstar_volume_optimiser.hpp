@@ -0,0 +1,66 @@
+#ifndef DARKSTARDTSCONVERTER_DARKSTAR_VOLUME_OPTIMISER_HPP
+#define DARKSTARDTSCONVERTER_DARKSTAR_VOLUME_OPTIMISER_HPP
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include "archive_plugin.hpp"
+#include "darkstar_volume_writer.hpp"
+
+namespace studio::resources::vol::darkstar
+{
+  constexpr auto default_page_size = std::size_t(4096);
+
+  enum class layout_order
+  {
+    original,
+    // Entries of the same type, such as shapes, bitmaps or palettes, are kept together.
+    type,
+    // Entries are laid out in the order of an access trace, followed by the rest grouped by type.
+    trace
+  };
+
+  struct optimise_options
+  {
+    std::size_t alignment = default_page_size;
+    layout_order order = layout_order::type;
+    // Names of entries in the order they are loaded, for layout_order::trace.
+    std::vector<std::string> trace;
+    // Compressed entries are stored uncompressed, so that they can be read straight from a mapping.
+    bool decompress = false;
+  };
+
+  // Where an entry is in a volume, from its block header to the end of its data.
+  struct volume_block
+  {
+    studio::resources::file_info info;
+    std::uint64_t stored_size;
+  };
+
+  // How much seeking it takes to read entries in a given order.
+  struct layout_stats
+  {
+    std::size_t reads;
+    // Jumps backwards, or forwards by at least a page, which read ahead does not cover.
+    std::size_t seeks;
+    std::size_t backward_seeks;
+    std::uint64_t seek_distance;
+    std::size_t pages_touched;
+    // Entries whose data does not start at the beginning of a page.
+    std::size_t unaligned_entries;
+  };
+
+  std::vector<volume_block> get_volume_blocks(std::basic_istream<std::byte>& volume);
+
+  // The blocks of a volume in the order an optimised volume would store them.
+  std::vector<volume_block> plan_layout(std::vector<volume_block> blocks, const optimise_options& options);
+
+  // Entries named in access_order which are not in the volume are skipped.
+  layout_stats measure_layout(const std::vector<volume_block>& blocks, const std::vector<std::string>& access_order, std::size_t page_size = default_page_size);
+
+  // Writes a copy of a volume with its entries laid out according to options. Compressed entries are copied without being recompressed.
+  vol_writer_stats optimise_volume(std::basic_istream<std::byte>& input, std::basic_ostream<std::byte>& output, const optimise_options& options);
+}// namespace studio::resources::vol::darkstar
+
+#endif//DARKSTARDTSCONVERTER_DARKSTAR_VOLUME_OPTIMISER_HPP
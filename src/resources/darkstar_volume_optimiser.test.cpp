@@ -0,0 +1,98 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include "darkstar_volume_optimiser.hpp"
+#include "darkstar_volume.hpp"
+
+namespace
+{
+  std::vector<std::byte> to_bytes(const std::string& value)
+  {
+    auto bytes = reinterpret_cast<const std::byte*>(value.data());
+    return std::vector<std::byte>(bytes, bytes + value.size());
+  }
+
+  std::string read_entry(std::basic_istream<std::byte>& volume, const studio::resources::file_info& info)
+  {
+    studio::resources::vol::darkstar::vol_file_archive archive;
+    std::basic_stringstream<std::byte> output;
+    volume.clear();
+    archive.extract_file_contents(volume, info, output);
+
+    auto contents = output.str();
+    return std::string(reinterpret_cast<const char*>(contents.data()), contents.size());
+  }
+}
+
+TEST_CASE("Optimised volumes keep their entries on page boundaries in access order", "[resources.darkstar_volume_optimiser]")
+{
+  namespace darkstar = studio::resources::vol::darkstar;
+
+  std::vector<std::pair<std::string, std::string>> files{
+    { "a.dts", std::string(5000, 'a') },
+    { "a.bmp", "bitmap a" },
+    { "b.dts", std::string(300, 'b') + "shape" },
+    { "b.bmp", "bitmap b" },
+    { "tribes.ppl", "palette" }
+  };
+
+  darkstar::vol_writer writer(studio::resources::compression_type::lz);
+
+  for (auto& [filename, contents] : files)
+  {
+    writer.add_file(filename, to_bytes(contents));
+  }
+
+  std::basic_stringstream<std::byte> original;
+  writer.write(original);
+
+  darkstar::optimise_options options;
+  options.order = darkstar::layout_order::trace;
+  options.trace = { "tribes.ppl", "b.bmp", "missing.dts" };
+
+  std::basic_stringstream<std::byte> optimised;
+  auto stats = darkstar::optimise_volume(original, optimised, options);
+  REQUIRE(stats.file_count == files.size());
+  REQUIRE(stats.padding_bytes > 0);
+
+  auto blocks = darkstar::get_volume_blocks(optimised);
+  REQUIRE(blocks.size() == files.size());
+
+  std::vector<std::string> order;
+
+  for (auto& block : blocks)
+  {
+    order.emplace_back(block.info.filename.string());
+    REQUIRE((block.info.offset + 8) % darkstar::default_page_size == 0);
+  }
+
+  REQUIRE(order == std::vector<std::string>{ "tribes.ppl", "b.bmp", "a.bmp", "a.dts", "b.dts" });
+
+  // The shapes are copied without being decompressed.
+  REQUIRE(blocks[3].info.compression_type == studio::resources::compression_type::lz);
+
+  for (auto& block : blocks)
+  {
+    auto expected = std::find_if(files.begin(), files.end(), [&](auto& file) { return file.first == block.info.filename; });
+    REQUIRE(read_entry(optimised, block.info) == expected->second);
+  }
+
+  auto before = darkstar::measure_layout(darkstar::get_volume_blocks(original), options.trace);
+  auto after = darkstar::measure_layout(blocks, options.trace);
+
+  REQUIRE(before.reads == 2);
+  REQUIRE(before.backward_seeks == 1);
+  REQUIRE(before.unaligned_entries == 2);
+  REQUIRE(after.backward_seeks == 0);
+  REQUIRE(after.unaligned_entries == 0);
+
+  options.decompress = true;
+  std::basic_stringstream<std::byte> decompressed;
+  original.clear();
+  darkstar::optimise_volume(original, decompressed, options);
+
+  for (auto& block : darkstar::get_volume_blocks(decompressed))
+  {
+    REQUIRE(block.info.compression_type == studio::resources::compression_type::none);
+  }
+}
@@ -0,0 +1,295 @@
+#include <array>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <algorithm>
+#include <execution>
+#include <stdexcept>
+#include "resources/darkstar_volume_writer.hpp"
+#include "resources/compression.hpp"
+
+namespace studio::resources::vol::darkstar
+{
+  using namespace std::literals;
+
+  namespace
+  {
+    constexpr auto block_header_size = 8u;
+    // The top byte of the size in a block header is used for flags, which leaves 24 bits for the size of compressed blocks.
+    constexpr auto max_compressed_block_size = std::size_t(0x00FFFFFF);
+    constexpr auto block_flags = std::uint32_t(0x80000000);
+
+    struct compressed_entry
+    {
+      studio::resources::compression_type compression_type;
+      std::size_t size;
+      std::vector<std::byte> block;
+      std::optional<std::string> error;
+    };
+
+    void write_string(std::basic_ostream<std::byte>& output, std::string_view value)
+    {
+      output.write(reinterpret_cast<const std::byte*>(value.data()), std::streamsize(value.size()));
+    }
+
+    void write_uint32(std::basic_ostream<std::byte>& output, std::uint32_t value)
+    {
+      std::array<std::byte, sizeof(value)> bytes{};
+
+      for (auto i = 0u; i < bytes.size(); ++i)
+      {
+        bytes[i] = std::byte((value >> (i * 8)) & 0xff);
+      }
+
+      output.write(bytes.data(), bytes.size());
+    }
+
+    std::vector<std::byte> read_source(const std::filesystem::path& path)
+    {
+      std::basic_ifstream<std::byte> input(path, std::ios::binary);
+
+      if (!input)
+      {
+        throw std::invalid_argument("Could not open " + path.string());
+      }
+
+      std::vector<std::byte> results(std::filesystem::file_size(path));
+      input.read(results.data(), std::streamsize(results.size()));
+
+      if (std::size_t(input.gcount()) != results.size())
+      {
+        throw std::invalid_argument("Could not read " + path.string());
+      }
+
+      return results;
+    }
+
+    std::vector<std::byte> compress_entry(studio::resources::compression_type compression, nonstd::span<const std::byte> contents)
+    {
+      switch (compression)
+      {
+      case studio::resources::compression_type::rle:
+        return studio::resources::compress_rle(contents);
+      case studio::resources::compression_type::lz:
+        return studio::resources::compress_lz(contents);
+      case studio::resources::compression_type::lzh:
+        return studio::resources::compress_lzh(contents);
+      default:
+        return {};
+      }
+    }
+  }// namespace
+
+  double vol_writer_stats::get_ratio() const
+  {
+    return uncompressed_bytes == 0 ? 1.0 : double(stored_bytes) / double(uncompressed_bytes);
+  }
+
+  double vol_writer_stats::get_throughput() const
+  {
+    return compression_time.count() <= 0 ? 0.0 : double(uncompressed_bytes) / compression_time.count();
+  }
+
+  vol_writer::vol_writer(studio::resources::compression_type compression, std::size_t alignment)
+    : compression(compression), alignment(std::max<std::size_t>(alignment, 1))
+  {
+  }
+
+  void vol_writer::add_file(std::string filename, std::vector<std::byte> contents)
+  {
+    add_entry(pending_entry{ std::move(filename), {}, std::move(contents), std::nullopt, 0 });
+  }
+
+  void vol_writer::add_file(const std::filesystem::path& path)
+  {
+    add_entry(pending_entry{ path.filename().string(), path, {}, std::nullopt, 0 });
+  }
+
+  void vol_writer::add_compressed_file(std::string filename, studio::resources::compression_type compression_type, std::size_t uncompressed_size, std::vector<std::byte> block)
+  {
+    if (compression_type != studio::resources::compression_type::none && block.size() > max_compressed_block_size)
+    {
+      throw std::invalid_argument("The compressed block of " + filename + " is too large for a volume.");
+    }
+
+    add_entry(pending_entry{ std::move(filename), {}, std::move(block), compression_type, uncompressed_size });
+  }
+
+  void vol_writer::add_entry(pending_entry entry)
+  {
+    if (entry.filename.empty() || entry.filename.find('\0') != std::string::npos)
+    {
+      throw std::invalid_argument("\"" + entry.filename + "\" cannot be used as the name of a volume entry.");
+    }
+
+    if (!names.emplace(studio::resources::normalise_path(entry.filename)).second)
+    {
+      throw std::invalid_argument("The volume already has an entry called " + entry.filename);
+    }
+
+    entries.emplace_back(std::move(entry));
+  }
+
+  std::size_t vol_writer::size() const
+  {
+    return entries.size();
+  }
+
+  vol_writer_stats vol_writer::write(std::basic_ostream<std::byte>& output) const
+  {
+    std::vector<compressed_entry> blocks(entries.size());
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::transform(std::execution::par, entries.begin(), entries.end(), blocks.begin(), [&](const pending_entry& entry) {
+      compressed_entry result{ studio::resources::compression_type::none, 0, {}, std::nullopt };
+
+      // Exceptions cannot leave a parallel algorithm without terminating, so they are reported afterwards.
+      try
+      {
+        if (entry.stored_compression.has_value())
+        {
+          result.compression_type = entry.stored_compression.value();
+          result.size = entry.uncompressed_size;
+          result.block = entry.contents;
+          return result;
+        }
+
+        std::vector<std::byte> loaded;
+
+        if (!entry.source_path.empty())
+        {
+          loaded = read_source(entry.source_path);
+        }
+
+        auto contents = nonstd::span<const std::byte>(entry.source_path.empty() ? entry.contents : loaded);
+        result.size = contents.size();
+
+        if (result.size > std::numeric_limits<std::uint32_t>::max())
+        {
+          throw std::invalid_argument("Entries of a volume cannot be larger than 4 GiB.");
+        }
+
+        if (compression != studio::resources::compression_type::none && !contents.empty())
+        {
+          auto block = compress_entry(compression, contents);
+
+          if (block.size() < contents.size() && block.size() <= max_compressed_block_size)
+          {
+            result.compression_type = compression;
+            result.block = std::move(block);
+            return result;
+          }
+        }
+
+        result.block = entry.source_path.empty() ? entry.contents : std::move(loaded);
+      }
+      catch (const std::exception& ex)
+      {
+        result.error = entry.filename + ": " + ex.what();
+      }
+
+      return result;
+    });
+
+    vol_writer_stats stats{};
+    stats.compression_time = std::chrono::steady_clock::now() - start;
+    stats.file_count = entries.size();
+
+    std::vector<std::uint32_t> offsets;
+    offsets.reserve(blocks.size());
+
+    std::vector<std::uint32_t> padding;
+    padding.reserve(blocks.size());
+
+    std::uint64_t position = block_header_size;
+    std::uint32_t string_size = 0;
+
+    for (auto i = 0u; i < blocks.size(); ++i)
+    {
+      if (blocks[i].error.has_value())
+      {
+        throw std::invalid_argument(blocks[i].error.value());
+      }
+
+      const auto data_position = position + block_header_size;
+      const auto aligned_position = (data_position + alignment - 1) / alignment * alignment;
+
+      padding.emplace_back(std::uint32_t(aligned_position - data_position));
+      stats.padding_bytes += padding.back();
+      position += padding.back();
+
+      offsets.emplace_back(std::uint32_t(position));
+      position += block_header_size + blocks[i].block.size();
+      string_size += std::uint32_t(entries[i].filename.size()) + 1;
+
+      stats.uncompressed_bytes += blocks[i].size;
+      stats.stored_bytes += block_header_size + blocks[i].block.size();
+    }
+
+    if (position > std::numeric_limits<std::uint32_t>::max())
+    {
+      throw std::invalid_argument("The entries do not fit in a single volume, which is limited to 4 GiB.");
+    }
+
+    write_string(output, " VOL"sv);
+    write_uint32(output, std::uint32_t(position));
+
+    const std::vector<std::byte> zeros(std::min<std::size_t>(alignment, 64 * 1024));
+
+    for (auto i = 0u; i < blocks.size(); ++i)
+    {
+      for (auto remaining = std::size_t(padding[i]); remaining > 0;)
+      {
+        const auto count = std::min(remaining, zeros.size());
+        output.write(zeros.data(), std::streamsize(count));
+        remaining -= count;
+      }
+
+      write_string(output, "VBLK"sv);
+      write_uint32(output, std::uint32_t(blocks[i].block.size()) | block_flags);
+      output.write(blocks[i].block.data(), std::streamsize(blocks[i].block.size()));
+    }
+
+    write_string(output, "vols"sv);
+    write_uint32(output, 0);
+    write_string(output, "voli"sv);
+    write_uint32(output, 0);
+    write_string(output, "vols"sv);
+    write_uint32(output, string_size);
+
+    // The string table is padded to an even size, which the reader skips over before it.
+    if (string_size % 2 != 0)
+    {
+      output.put(std::byte{ 0 });
+    }
+
+    std::uint32_t name_offset = 0;
+
+    for (auto& entry : entries)
+    {
+      write_string(output, entry.filename);
+      output.put(std::byte{ 0 });
+    }
+
+    write_string(output, "voli"sv);
+    write_uint32(output, std::uint32_t(entries.size() * 17));
+
+    for (auto i = 0u; i < entries.size(); ++i)
+    {
+      write_uint32(output, 0);
+      write_uint32(output, name_offset);
+      write_uint32(output, offsets[i]);
+      write_uint32(output, std::uint32_t(blocks[i].size));
+      output.put(std::byte(blocks[i].compression_type));
+      name_offset += std::uint32_t(entries[i].filename.size()) + 1;
+    }
+
+    if (!output)
+    {
+      throw std::invalid_argument("The volume could not be written.");
+    }
+
+    return stats;
+  }
+}// namespace studio::resources::vol::darkstar
@@ -0,0 +1,75 @@
+#ifndef DARKSTARDTSCONVERTER_DARKSTAR_VOLUME_WRITER_HPP
+#define DARKSTARDTSCONVERTER_DARKSTAR_VOLUME_WRITER_HPP
+
+#include <set>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <optional>
+#include <ostream>
+#include <filesystem>
+#include <nonstd/span.hpp>
+#include "archive_plugin.hpp"
+
+namespace studio::resources::vol::darkstar
+{
+  struct vol_writer_stats
+  {
+    std::size_t file_count;
+    std::uint64_t uncompressed_bytes;
+    // The size of the entry data in the volume, block headers included.
+    std::uint64_t stored_bytes;
+    // Bytes added between blocks to align them.
+    std::uint64_t padding_bytes;
+    std::chrono::duration<double> compression_time;
+
+    // Stored bytes for each uncompressed byte, so smaller is better.
+    double get_ratio() const;
+
+    // Uncompressed bytes compressed per second.
+    double get_throughput() const;
+  };
+
+  // Builds a Darkstar VOL from files in memory or on disk.
+  // Entries are compressed in parallel when the volume is written, and then the volume is written front to back in one go.
+  // An entry which does not get any smaller is stored as is.
+  class vol_writer
+  {
+  public:
+    // With an alignment, the data of every entry starts on a multiple of it, such as the page size.
+    explicit vol_writer(studio::resources::compression_type compression = studio::resources::compression_type::lz, std::size_t alignment = 1);
+
+    // Entries are looked up by name alone, so each name can only be added once, regardless of case.
+    void add_file(std::string filename, std::vector<std::byte> contents);
+
+    // The file is only read when the volume is written.
+    void add_file(const std::filesystem::path& path);
+
+    // Adds an entry which is already compressed, such as one copied from another volume, to be stored as it is.
+    void add_compressed_file(std::string filename, studio::resources::compression_type compression_type, std::size_t uncompressed_size, std::vector<std::byte> block);
+
+    std::size_t size() const;
+
+    vol_writer_stats write(std::basic_ostream<std::byte>& output) const;
+
+  private:
+    struct pending_entry
+    {
+      std::string filename;
+      std::filesystem::path source_path;
+      std::vector<std::byte> contents;
+      // Set for entries added with add_compressed_file.
+      std::optional<studio::resources::compression_type> stored_compression;
+      std::size_t uncompressed_size;
+    };
+
+    void add_entry(pending_entry entry);
+
+    studio::resources::compression_type compression;
+    std::size_t alignment;
+    std::vector<pending_entry> entries;
+    std::set<std::string> names;
+  };
+}// namespace studio::resources::vol::darkstar
+
+#endif//DARKSTARDTSCONVERTER_DARKSTAR_VOLUME_WRITER_HPP
@@ -0,0 +1,77 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include "darkstar_volume_writer.hpp"
+#include "darkstar_volume.hpp"
+
+namespace
+{
+  std::vector<std::byte> to_bytes(std::string_view value)
+  {
+    auto bytes = reinterpret_cast<const std::byte*>(value.data());
+    return std::vector<std::byte>(bytes, bytes + value.size());
+  }
+}
+
+TEST_CASE("Volumes written with compression are read back as they were added", "[resources.darkstar_volume_writer]")
+{
+  std::string repeated;
+
+  for (auto i = 0; i < 2000; ++i)
+  {
+    repeated += std::string(40, ' ') + "terrain tile " + std::to_string(i % 17) + ";";
+  }
+
+  auto compression = GENERATE(studio::resources::compression_type::none, studio::resources::compression_type::rle, studio::resources::compression_type::lz, studio::resources::compression_type::lzh);
+
+  studio::resources::vol::darkstar::vol_writer writer(compression);
+  writer.add_file("tiles.dat", to_bytes(repeated));
+  writer.add_file("odd.txt", to_bytes("xyz"));
+  writer.add_file("empty.cs", {});
+
+  REQUIRE_THROWS_AS(writer.add_file("TILES.DAT", {}), std::invalid_argument);
+  REQUIRE(writer.size() == 3);
+
+  std::basic_stringstream<std::byte> volume;
+  auto stats = writer.write(volume);
+
+  REQUIRE(stats.file_count == 3);
+  REQUIRE(stats.uncompressed_bytes == repeated.size() + 3);
+
+  if (compression == studio::resources::compression_type::none)
+  {
+    REQUIRE(stats.stored_bytes == stats.uncompressed_bytes + 3 * 8);
+  }
+  else
+  {
+    REQUIRE(stats.get_ratio() < 0.5);
+  }
+
+  studio::resources::vol::darkstar::vol_file_archive archive;
+  volume.seekg(0);
+  REQUIRE(archive.stream_is_supported(volume));
+
+  auto listing = archive.get_content_listing(volume, "test.vol");
+  REQUIRE(listing.size() == 3);
+
+  std::vector<std::string> expected{ repeated, "xyz", "" };
+
+  for (auto i = 0u; i < listing.size(); ++i)
+  {
+    auto& info = std::get<studio::resources::file_info>(listing[i]);
+    REQUIRE(info.size == expected[i].size());
+
+    // Entries which would not get any smaller are kept as they are.
+    if (i > 0)
+    {
+      REQUIRE(info.compression_type == studio::resources::compression_type::none);
+    }
+
+    std::basic_stringstream<std::byte> output;
+    volume.clear();
+    archive.extract_file_contents(volume, info, output);
+
+    auto contents = output.str();
+    REQUIRE(std::string(reinterpret_cast<const char*>(contents.data()), contents.size()) == expected[i]);
+  }
+}
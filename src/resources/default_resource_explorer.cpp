@@ -0,0 +1,26 @@
+#include "default_resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "three_space_volume.hpp"
+#include "trophy_bass_volume.hpp"
+#include "content/mis/mission.hpp"
+
+namespace studio::resources
+{
+  resource_explorer create_default_resource_explorer(const std::filesystem::path& search_path)
+  {
+    resource_explorer archive(search_path);
+
+    archive.add_archive_type(".mis", std::make_unique<mis::darkstar::mis_file_archive>(), mis::darkstar::mis_file_archive::supported_extensions);
+    archive.add_archive_type(".tbv", std::make_unique<vol::trophy_bass::tbv_file_archive>());
+    archive.add_archive_type(".rbx", std::make_unique<vol::trophy_bass::rbx_file_archive>());
+    archive.add_archive_type(".rmf", std::make_unique<vol::three_space::rmf_file_archive>());
+    archive.add_archive_type(".map", std::make_unique<vol::three_space::rmf_file_archive>());
+    archive.add_archive_type(".vga", std::make_unique<vol::three_space::rmf_file_archive>());
+
+    archive.add_archive_type(".dyn", std::make_unique<vol::three_space::dyn_file_archive>());
+    archive.add_archive_type(".vol", std::make_unique<vol::three_space::vol_file_archive>());
+    archive.add_archive_type(".vol", std::make_unique<vol::darkstar::vol_file_archive>());
+
+    return archive;
+  }
+}// namespace studio::resources
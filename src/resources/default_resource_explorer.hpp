@@ -0,0 +1,13 @@
+#ifndef DARKSTARDTSCONVERTER_DEFAULT_RESOURCE_EXPLORER_HPP
+#define DARKSTARDTSCONVERTER_DEFAULT_RESOURCE_EXPLORER_HPP
+
+#include <filesystem>
+#include "resource_explorer.hpp"
+
+namespace studio::resources
+{
+  // An explorer with every archive format the project can read.
+  resource_explorer create_default_resource_explorer(const std::filesystem::path& search_path);
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_DEFAULT_RESOURCE_EXPLORER_HPP
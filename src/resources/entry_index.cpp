@@ -0,0 +1,52 @@
+#include "entry_index.hpp"
+
+namespace studio::resources
+{
+  void entry_index::insert(const std::filesystem::path& folder_path, const std::vector<content_info>& listing)
+  {
+    entry_table table(listing);
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    auto& existing = listings[folder_path];
+
+    for (auto i = 0u; i < existing.size(); ++i)
+    {
+      if (existing.kind(i) == entry_table::entry_kind::file)
+      {
+        entries.erase(normalise_path(existing.path(i) / std::filesystem::u8path(existing.name(i))));
+      }
+    }
+
+    existing = std::move(table);
+    entries.reserve(entries.size() + existing.size());
+
+    for (auto i = 0u; i < existing.size(); ++i)
+    {
+      if (existing.kind(i) == entry_table::entry_kind::file)
+      {
+        entries.insert_or_assign(normalise_path(existing.path(i) / std::filesystem::u8path(existing.name(i))), entry_handle{ &existing, i });
+      }
+    }
+  }
+
+  std::optional<file_info> entry_index::find(const std::filesystem::path& file_path) const
+  {
+    const auto key = normalise_path(file_path);
+
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    if (auto existing = entries.find(key); existing != entries.end())
+    {
+      return existing->second.table->get_file(existing->second.index);
+    }
+
+    return std::nullopt;
+  }
+
+  std::size_t entry_index::size() const
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return entries.size();
+  }
+}// namespace studio::resources
@@ -0,0 +1,42 @@
+#ifndef DARKSTARDTSCONVERTER_ENTRY_INDEX_HPP
+#define DARKSTARDTSCONVERTER_ENTRY_INDEX_HPP
+
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <optional>
+#include <unordered_map>
+#include <filesystem>
+#include "archive_plugin.hpp"
+#include "entry_table.hpp"
+
+namespace studio::resources
+{
+  // Every file listed so far, by its full path inside of the workspace, ignoring case.
+  class entry_index
+  {
+  public:
+    using content_info = archive_plugin::content_info;
+
+    // Replaces whatever was known about the folder before.
+    void insert(const std::filesystem::path& folder_path, const std::vector<content_info>& listing);
+
+    std::optional<file_info> find(const std::filesystem::path& file_path) const;
+
+    std::size_t size() const;
+
+  private:
+    struct entry_handle
+    {
+      const entry_table* table;
+      std::size_t index;
+    };
+
+    mutable std::shared_mutex mutex;
+    std::map<std::filesystem::path, entry_table> listings;
+    std::unordered_map<std::string, entry_handle> entries;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_ENTRY_INDEX_HPP
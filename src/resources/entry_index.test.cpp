@@ -0,0 +1,31 @@
+#include <catch2/catch.hpp>
+#include "entry_index.hpp"
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Listed files can be found by path without regard to case", "[resources.entry_index]")
+{
+  temp_folder folder("3space-lookup-test");
+  auto volume_path = folder.path / "Shapes.vol";
+
+  write_darkstar_vol(volume_path, { { "LArmor.dts", "shape data" }, { "tribes.ppl", "palette" } });
+  std::ofstream(folder.path / "readme.txt") << "hello";
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  REQUIRE_FALSE(explorer.find_file(volume_path / "larmor.dts").has_value());
+
+  explorer.find_files({ "ALL" });
+
+  auto shape = explorer.find_file(folder.path / "shapes.VOL" / "larmor.DTS");
+  REQUIRE(shape.has_value());
+  REQUIRE(shape->filename == "LArmor.dts");
+  REQUIRE(shape->size == 10);
+
+  REQUIRE(explorer.find_file(folder.path / "README.txt").has_value());
+  REQUIRE_FALSE(explorer.find_file(folder.path / "missing.txt").has_value());
+}
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include "entry_table.hpp"
+
+namespace studio::resources
+{
+  entry_table::entry_table(const std::vector<content_info>& listing)
+  {
+    reserve(listing.size());
+
+    for (auto& item : listing)
+    {
+      push_back(item);
+    }
+  }
+
+  entry_table::entry_table(const std::vector<file_info>& files)
+  {
+    reserve(files.size());
+
+    for (auto& info : files)
+    {
+      push_back(info);
+    }
+  }
+
+  void entry_table::reserve(std::size_t entry_count)
+  {
+    name_offsets.reserve(entry_count);
+    path_ids.reserve(entry_count);
+    offsets.reserve(entry_count);
+    sizes.reserve(entry_count);
+    kinds.reserve(entry_count);
+    compression_types.reserve(entry_count);
+  }
+
+  std::uint32_t entry_table::add_name(std::string_view name)
+  {
+    const auto result = std::uint32_t(names.size());
+    names.append(name);
+    return result;
+  }
+
+  std::uint32_t entry_table::add_path(const std::filesystem::path& path)
+  {
+    if (!paths.empty() && paths.back() == path)
+    {
+      return std::uint32_t(paths.size() - 1);
+    }
+
+    auto [existing, is_new] = path_lookup.emplace(path, std::uint32_t(paths.size()));
+
+    if (is_new)
+    {
+      paths.emplace_back(path);
+    }
+
+    return existing->second;
+  }
+
+  void entry_table::push_back(const content_info& item)
+  {
+    std::visit([&](const auto& info) { push_back(info); }, item);
+  }
+
+  void entry_table::push_back(const file_info& info)
+  {
+    if constexpr (std::is_same_v<std::filesystem::path::value_type, char>)
+    {
+      name_offsets.emplace_back(add_name(info.filename.native()));
+    }
+    else
+    {
+      name_offsets.emplace_back(add_name(info.filename.u8string()));
+    }
+    path_ids.emplace_back(add_path(info.folder_path));
+    offsets.emplace_back(info.offset);
+    sizes.emplace_back(info.size);
+    kinds.emplace_back(entry_kind::file);
+    compression_types.emplace_back(std::uint8_t(info.compression_type));
+
+    if (info.checksum.has_value())
+    {
+      checksums.emplace_back(std::uint32_t(kinds.size() - 1), info.checksum.value());
+    }
+  }
+
+  void entry_table::push_back(const folder_info& info)
+  {
+    name_offsets.emplace_back(add_name(info.name));
+    path_ids.emplace_back(add_path(info.full_path));
+    offsets.emplace_back(0);
+    sizes.emplace_back(info.file_count.has_value() ? info.file_count.value() + 1 : 0);
+    kinds.emplace_back(entry_kind::folder);
+    compression_types.emplace_back(std::uint8_t(compression_type::none));
+  }
+
+  std::size_t entry_table::size() const
+  {
+    return kinds.size();
+  }
+
+  bool entry_table::empty() const
+  {
+    return kinds.empty();
+  }
+
+  entry_table::entry_kind entry_table::kind(std::size_t index) const
+  {
+    return kinds[index];
+  }
+
+  std::string_view entry_table::name(std::size_t index) const
+  {
+    const auto end = index + 1 < name_offsets.size() ? name_offsets[index + 1] : names.size();
+    return std::string_view(names).substr(name_offsets[index], end - name_offsets[index]);
+  }
+
+  const std::filesystem::path& entry_table::path(std::size_t index) const
+  {
+    return paths[path_ids[index]];
+  }
+
+  std::uint64_t entry_table::offset(std::size_t index) const
+  {
+    return offsets[index];
+  }
+
+  std::uint64_t entry_table::size(std::size_t index) const
+  {
+    return kinds[index] == entry_kind::file ? sizes[index] : 0;
+  }
+
+  compression_type entry_table::compression(std::size_t index) const
+  {
+    return compression_type(compression_types[index]);
+  }
+
+  std::optional<std::size_t> entry_table::file_count(std::size_t index) const
+  {
+    if (kinds[index] == entry_kind::file || sizes[index] == 0)
+    {
+      return std::nullopt;
+    }
+
+    return std::size_t(sizes[index] - 1);
+  }
+
+  std::optional<std::uint32_t> entry_table::checksum(std::size_t index) const
+  {
+    auto existing = std::lower_bound(checksums.begin(), checksums.end(), std::uint32_t(index), [](const auto& item, auto value) {
+      return item.first < value;
+    });
+
+    if (existing == checksums.end() || existing->first != index)
+    {
+      return std::nullopt;
+    }
+
+    return existing->second;
+  }
+
+  file_info entry_table::get_file(std::size_t index) const
+  {
+    file_info info{};
+    info.filename = std::filesystem::u8path(name(index));
+    info.offset = std::size_t(offsets[index]);
+    info.size = std::size_t(sizes[index]);
+    info.compression_type = compression(index);
+    info.folder_path = path(index);
+    info.checksum = checksum(index);
+    return info;
+  }
+
+  folder_info entry_table::get_folder(std::size_t index) const
+  {
+    folder_info info{};
+    info.name = std::string(name(index));
+    info.file_count = file_count(index);
+    info.full_path = path(index);
+    return info;
+  }
+
+  entry_table::content_info entry_table::at(std::size_t index) const
+  {
+    if (kinds[index] == entry_kind::folder)
+    {
+      return get_folder(index);
+    }
+
+    return get_file(index);
+  }
+
+  std::vector<entry_table::content_info> entry_table::get_contents() const
+  {
+    std::vector<content_info> results;
+    results.reserve(size());
+
+    for (auto i = 0u; i < size(); ++i)
+    {
+      results.emplace_back(at(i));
+    }
+
+    return results;
+  }
+
+  std::vector<file_info> entry_table::get_files() const
+  {
+    std::vector<file_info> results;
+    results.reserve(std::size_t(std::count(kinds.begin(), kinds.end(), entry_kind::file)));
+
+    for (auto i = 0u; i < size(); ++i)
+    {
+      if (kinds[i] == entry_kind::file)
+      {
+        results.emplace_back(get_file(i));
+      }
+    }
+
+    return results;
+  }
+
+  std::size_t entry_table::memory_usage() const
+  {
+    auto result = names.capacity()
+                  + name_offsets.capacity() * sizeof(std::uint32_t)
+                  + path_ids.capacity() * sizeof(std::uint32_t)
+                  + offsets.capacity() * sizeof(std::uint64_t)
+                  + sizes.capacity() * sizeof(std::uint64_t)
+                  + kinds.capacity() * sizeof(entry_kind)
+                  + compression_types.capacity() * sizeof(std::uint8_t)
+                  + checksums.capacity() * sizeof(std::pair<std::uint32_t, std::uint32_t>)
+                  + paths.capacity() * sizeof(std::filesystem::path);
+
+    for (auto& path : paths)
+    {
+      // Each path is also a key of the lookup, so it is counted twice.
+      result += 2 * path.native().capacity() * sizeof(std::filesystem::path::value_type);
+    }
+
+    return result;
+  }
+}// namespace studio::resources
@@ -0,0 +1,80 @@
+#ifndef DARKSTARDTSCONVERTER_ENTRY_TABLE_HPP
+#define DARKSTARDTSCONVERTER_ENTRY_TABLE_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <filesystem>
+#include "archive_plugin.hpp"
+
+namespace studio::resources
+{
+  // A compact, column based copy of an archive listing, for listings which are kept around.
+  // All names share one string buffer and every folder path is stored only once.
+  // Entries are turned back into folder_info and file_info when they are read.
+  class entry_table
+  {
+  public:
+    using content_info = archive_plugin::content_info;
+
+    enum class entry_kind : std::uint8_t
+    {
+      folder,
+      file
+    };
+
+    entry_table() = default;
+    explicit entry_table(const std::vector<content_info>& listing);
+    explicit entry_table(const std::vector<file_info>& files);
+
+    void reserve(std::size_t entry_count);
+
+    void push_back(const content_info& item);
+    void push_back(const file_info& info);
+    void push_back(const folder_info& info);
+
+    std::size_t size() const;
+    bool empty() const;
+
+    entry_kind kind(std::size_t index) const;
+    std::string_view name(std::size_t index) const;
+    // The folder holding a file, or the full path of a folder.
+    const std::filesystem::path& path(std::size_t index) const;
+    std::uint64_t offset(std::size_t index) const;
+    std::uint64_t size(std::size_t index) const;
+    compression_type compression(std::size_t index) const;
+    std::optional<std::size_t> file_count(std::size_t index) const;
+    std::optional<std::uint32_t> checksum(std::size_t index) const;
+
+    content_info at(std::size_t index) const;
+    file_info get_file(std::size_t index) const;
+    folder_info get_folder(std::size_t index) const;
+
+    std::vector<content_info> get_contents() const;
+    std::vector<file_info> get_files() const;
+
+    // The heap memory used by the table, roughly.
+    std::size_t memory_usage() const;
+
+  private:
+    std::uint32_t add_name(std::string_view name);
+    std::uint32_t add_path(const std::filesystem::path& path);
+
+    std::string names;
+    std::vector<std::uint32_t> name_offsets;
+    std::vector<std::uint32_t> path_ids;
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::uint64_t> sizes;
+    std::vector<entry_kind> kinds;
+    std::vector<std::uint8_t> compression_types;
+    // Only a few formats store checksums, so they are kept as (index, checksum) pairs in index order.
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> checksums;
+
+    std::vector<std::filesystem::path> paths;
+    std::map<std::filesystem::path, std::uint32_t> path_lookup;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_ENTRY_TABLE_HPP
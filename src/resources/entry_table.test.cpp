@@ -0,0 +1,74 @@
+#include <catch2/catch.hpp>
+#include "entry_table.hpp"
+
+TEST_CASE("Entry tables give back the listing they were made from", "[resources.entry_table]")
+{
+  using namespace studio::resources;
+
+  std::vector<entry_table::content_info> listing;
+
+  folder_info folder{};
+  folder.name = "shapes";
+  folder.file_count = 2;
+  folder.full_path = std::filesystem::path("game") / "tribes.vol" / "shapes";
+  listing.emplace_back(folder);
+
+  for (auto i = 0; i < 100; ++i)
+  {
+    file_info info{};
+    info.filename = "file" + std::to_string(i) + ".dts";
+    info.offset = std::size_t(i) * 1000;
+    info.size = std::size_t(i) + 1;
+    info.compression_type = i % 2 == 0 ? compression_type::none : compression_type::lzh;
+    info.folder_path = std::filesystem::path("game") / "tribes.vol";
+
+    if (i % 3 == 0)
+    {
+      info.checksum = std::uint32_t(i) * 7919;
+    }
+
+    listing.emplace_back(info);
+  }
+
+  folder.name = "empty";
+  folder.file_count = std::nullopt;
+  folder.full_path = std::filesystem::path("game") / "tribes.vol" / "empty";
+  listing.emplace_back(folder);
+
+  entry_table table(listing);
+
+  REQUIRE(table.size() == listing.size());
+  REQUIRE(table.kind(0) == entry_table::entry_kind::folder);
+  REQUIRE(table.name(50) == "file49.dts");
+  REQUIRE(table.path(1) == table.path(100));
+  REQUIRE(&table.path(1) == &table.path(100));
+
+  auto contents = table.get_contents();
+
+  for (auto i = 0u; i < listing.size(); ++i)
+  {
+    REQUIRE(contents[i].index() == listing[i].index());
+
+    if (auto* expected = std::get_if<file_info>(&listing[i]); expected)
+    {
+      auto& actual = std::get<file_info>(contents[i]);
+      REQUIRE(actual.filename == expected->filename);
+      REQUIRE(actual.offset == expected->offset);
+      REQUIRE(actual.size == expected->size);
+      REQUIRE(actual.compression_type == expected->compression_type);
+      REQUIRE(actual.folder_path == expected->folder_path);
+      REQUIRE(actual.checksum == expected->checksum);
+    }
+    else
+    {
+      auto& expected_folder = std::get<folder_info>(listing[i]);
+      auto& actual = std::get<folder_info>(contents[i]);
+      REQUIRE(actual.name == expected_folder.name);
+      REQUIRE(actual.file_count == expected_folder.file_count);
+      REQUIRE(actual.full_path == expected_folder.full_path);
+    }
+  }
+
+  REQUIRE(table.get_files().size() == 100);
+  REQUIRE(table.memory_usage() < listing.size() * sizeof(entry_table::content_info));
+}
@@ -0,0 +1,206 @@
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include "extraction_manifest.hpp"
+#include "archive_plugin.hpp"
+
+namespace studio::resources
+{
+  // Version 1 kept archive paths as they were given, which could be relative to a different folder on the next run.
+  constexpr auto manifest_header = "3space-manifest 2";
+
+  namespace
+  {
+    // Archives are recorded by absolute path, so that a run from another folder still finds the same ones.
+    std::filesystem::path get_absolute_path(const std::filesystem::path& path)
+    {
+      return std::filesystem::absolute(path).lexically_normal();
+    }
+  }// namespace
+
+  bool archive_state::operator==(const archive_state& other) const
+  {
+    return size == other.size && mtime == other.mtime;
+  }
+
+  extraction_manifest::extraction_manifest(std::filesystem::path root) : root(std::move(root))
+  {
+    std::ifstream input(this->root / manifest_filename);
+    std::string line;
+
+    // A manifest which cannot be read only means that every file is checked again.
+    if (!std::getline(input, line) || line != manifest_header)
+    {
+      return;
+    }
+
+    while (std::getline(input, line))
+    {
+      std::istringstream fields(line);
+      manifest_entry entry{};
+      std::string file_path;
+
+      fields >> std::hex >> entry.hash >> std::dec >> entry.size >> entry.archive.size >> entry.archive.mtime;
+      fields.ignore(1);
+
+      if (fields && std::getline(fields, entry.archive_path, '\t') && std::getline(fields, file_path) && !file_path.empty())
+      {
+        entries.emplace(std::move(file_path), std::move(entry));
+      }
+    }
+  }
+
+  archive_state extraction_manifest::get_archive_state(const std::filesystem::path& archive_path)
+  {
+    std::error_code error;
+    archive_state result{};
+
+    result.size = std::filesystem::file_size(archive_path, error);
+
+    // Whole seconds are not enough to notice an archive which is patched straight after being extracted.
+    if (auto write_time = std::filesystem::last_write_time(archive_path, error); !error)
+    {
+      result.mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(write_time.time_since_epoch()).count();
+    }
+
+    return result;
+  }
+
+  std::string extraction_manifest::get_key(const std::filesystem::path& file_path) const
+  {
+    return file_path.lexically_normal().lexically_relative(root.lexically_normal()).generic_u8string();
+  }
+
+  bool extraction_manifest::is_unchanged(const std::filesystem::path& file_path, const std::filesystem::path& archive_path, const archive_state& archive, std::uint64_t size)
+  {
+    const auto absolute_archive_path = normalise_path(get_absolute_path(archive_path));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    archives.emplace(absolute_archive_path);
+
+    auto existing = entries.find(get_key(file_path));
+
+    if (existing == entries.end() || existing->second.size != size || !(existing->second.archive == archive)
+        || normalise_path(std::filesystem::u8path(existing->second.archive_path)) != absolute_archive_path)
+    {
+      return false;
+    }
+
+    std::error_code error;
+
+    if (std::filesystem::file_size(file_path, error) != size || error)
+    {
+      return false;
+    }
+
+    existing->second.seen = true;
+    return true;
+  }
+
+  bool extraction_manifest::has_contents(const std::filesystem::path& file_path, const std::filesystem::path& archive_path, const archive_state& archive, std::uint64_t size, std::uint64_t hash)
+  {
+    const auto absolute_archive_path = get_absolute_path(archive_path);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    archives.emplace(normalise_path(absolute_archive_path));
+
+    auto existing = entries.find(get_key(file_path));
+
+    if (existing == entries.end() || existing->second.size != size || existing->second.hash != hash)
+    {
+      return false;
+    }
+
+    std::error_code error;
+
+    if (std::filesystem::file_size(file_path, error) != size || error)
+    {
+      return false;
+    }
+
+    existing->second.archive_path = absolute_archive_path.generic_u8string();
+    existing->second.archive = archive;
+    existing->second.seen = true;
+    return true;
+  }
+
+  void extraction_manifest::add(const std::filesystem::path& file_path, const std::filesystem::path& archive_path, const archive_state& archive, std::uint64_t size, std::uint64_t hash)
+  {
+    const auto absolute_archive_path = get_absolute_path(archive_path);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    archives.emplace(normalise_path(absolute_archive_path));
+    entries[get_key(file_path)] = manifest_entry{ size, hash, absolute_archive_path.generic_u8string(), archive, true };
+  }
+
+  void extraction_manifest::mark_failed(const std::filesystem::path& archive_path)
+  {
+    const auto absolute_archive_path = normalise_path(get_absolute_path(archive_path));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    failed_archives.emplace(absolute_archive_path);
+  }
+
+  std::vector<std::filesystem::path> extraction_manifest::remove_stale()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::filesystem::path> results;
+
+    for (auto entry = entries.begin(); entry != entries.end();)
+    {
+      std::error_code error;
+      const auto archive = normalise_path(std::filesystem::u8path(entry->second.archive_path));
+      const auto archive_in_run = archives.count(archive) != 0;
+
+      if (entry->second.seen || failed_archives.count(archive) != 0 || (!archive_in_run && std::filesystem::exists(std::filesystem::u8path(entry->second.archive_path), error)))
+      {
+        ++entry;
+        continue;
+      }
+
+      auto file_path = root / std::filesystem::u8path(entry->first);
+      std::filesystem::remove(file_path, error);
+
+      results.emplace_back(std::move(file_path));
+      entry = entries.erase(entry);
+    }
+
+    return results;
+  }
+
+  void extraction_manifest::save() const
+  {
+    // The manifest is replaced in one go, so that an interrupted save leaves the old one behind.
+    auto manifest_path = root / manifest_filename;
+    auto temp_path = manifest_path;
+    temp_path += ".tmp";
+
+    {
+      std::ofstream output(temp_path, std::ios::trunc);
+      output << manifest_header << '\n';
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      for (auto& [file_path, entry] : entries)
+      {
+        output << std::hex << std::setw(16) << std::setfill('0') << entry.hash << std::dec << ' ' << entry.size << ' '
+               << entry.archive.size << ' ' << entry.archive.mtime << '\t' << entry.archive_path << '\t' << file_path << '\n';
+      }
+
+      if (!output.flush())
+      {
+        throw std::invalid_argument("Could not write " + temp_path.string());
+      }
+    }
+
+    std::filesystem::rename(temp_path, manifest_path);
+  }
+
+  std::size_t extraction_manifest::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+  }
+}// namespace studio::resources
@@ -0,0 +1,80 @@
+#ifndef DARKSTARDTSCONVERTER_EXTRACTION_MANIFEST_HPP
+#define DARKSTARDTSCONVERTER_EXTRACTION_MANIFEST_HPP
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <filesystem>
+
+namespace studio::resources
+{
+  struct archive_state
+  {
+    std::uint64_t size;
+    // In nanoseconds of the file clock, which is only compared with values from the same machine.
+    std::int64_t mtime;
+
+    bool operator==(const archive_state& other) const;
+  };
+
+  // What an earlier extraction wrote into a folder, so that a later one only has to write what has changed.
+  // A file is skipped without being read when its archive has the same size and modification time as before,
+  // and otherwise when the hash of its new contents matches the one it was written with.
+  class extraction_manifest
+  {
+  public:
+    static constexpr std::string_view manifest_filename = ".3space-manifest";
+
+    // Reads the manifest of root, if there is one.
+    explicit extraction_manifest(std::filesystem::path root);
+
+    static archive_state get_archive_state(const std::filesystem::path& archive_path);
+
+    // Whether file_path came from the same archive, which has not changed since, and is still on disk at the same size.
+    bool is_unchanged(const std::filesystem::path& file_path, const std::filesystem::path& archive_path, const archive_state& archive, std::uint64_t size);
+
+    // Whether file_path already has contents of this size and hash on disk.
+    // If so, its entry is updated to the current state of the archive, so that the next run can skip it without reading it.
+    bool has_contents(const std::filesystem::path& file_path, const std::filesystem::path& archive_path, const archive_state& archive, std::uint64_t size, std::uint64_t hash);
+
+    // Records a file which has just been written.
+    void add(const std::filesystem::path& file_path, const std::filesystem::path& archive_path, const archive_state& archive, std::uint64_t size, std::uint64_t hash);
+
+    // Records that an entry of archive_path could not be extracted.
+    // The earlier files of that archive are then kept, since the one which failed cannot be told apart from one which is stale.
+    void mark_failed(const std::filesystem::path& archive_path);
+
+    // Deletes the files written by earlier runs which this one has not extracted, and returns their paths.
+    // Only files from archives this run has looked at, or from archives which no longer exist, count as stale.
+    std::vector<std::filesystem::path> remove_stale();
+
+    void save() const;
+
+    std::size_t size() const;
+
+  private:
+    struct manifest_entry
+    {
+      std::uint64_t size;
+      std::uint64_t hash;
+      std::string archive_path;
+      archive_state archive;
+      // Whether this run has extracted the file or found it up to date.
+      bool seen;
+    };
+
+    std::string get_key(const std::filesystem::path& file_path) const;
+
+    std::filesystem::path root;
+    mutable std::mutex mutex;
+    std::map<std::string, manifest_entry> entries;
+    std::set<std::string> archives;
+    std::set<std::string> failed_archives;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_EXTRACTION_MANIFEST_HPP
@@ -0,0 +1,74 @@
+#include <catch2/catch.hpp>
+#include <fstream>
+#include "extraction_manifest.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+namespace
+{
+  // Changes the working folder for the length of a test, and changes it back however the test ends.
+  struct current_path_guard
+  {
+    std::filesystem::path previous = std::filesystem::current_path();
+
+    explicit current_path_guard(const std::filesystem::path& path)
+    {
+      std::filesystem::current_path(path);
+    }
+
+    current_path_guard(const current_path_guard&) = delete;
+    current_path_guard& operator=(const current_path_guard&) = delete;
+
+    ~current_path_guard()
+    {
+      std::error_code error;
+      std::filesystem::current_path(previous, error);
+    }
+  };
+
+  void write_text(const std::filesystem::path& path, std::string_view contents)
+  {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << contents;
+  }
+}
+
+TEST_CASE("The extraction manifest keeps files of archives given relative to another folder", "[resources.extraction_manifest]")
+{
+  temp_folder folder("3space-manifest-test");
+  auto destination = folder.path / "out";
+  std::filesystem::create_directories(destination);
+  std::filesystem::create_directories(folder.path / "elsewhere");
+
+  write_text(folder.path / "a.vol", "first archive");
+  write_text(folder.path / "b.vol", "second archive");
+  write_text(destination / "a.bin", "a");
+  write_text(destination / "c.bin", "c");
+
+  {
+    current_path_guard guard(folder.path);
+    studio::resources::extraction_manifest manifest(destination);
+
+    manifest.add(destination / "a.bin", "./a.vol", studio::resources::extraction_manifest::get_archive_state("a.vol"), 1, 1);
+    manifest.add(destination / "c.bin", "./b.vol", studio::resources::extraction_manifest::get_archive_state("b.vol"), 1, 2);
+    manifest.save();
+  }
+
+  // Only a.vol is extracted again, and from a folder in which b.vol is not found by the path it was first given as.
+  current_path_guard guard(folder.path / "elsewhere");
+  studio::resources::extraction_manifest manifest(destination);
+  const auto archive_path = std::filesystem::path("..") / "a.vol";
+
+  REQUIRE(manifest.size() == 2);
+  REQUIRE(manifest.is_unchanged(destination / "a.bin", archive_path, studio::resources::extraction_manifest::get_archive_state(archive_path), 1));
+
+  REQUIRE(manifest.remove_stale().empty());
+  REQUIRE(std::filesystem::exists(destination / "c.bin"));
+
+  // Once b.vol is gone, its file is stale wherever the run is started from.
+  std::filesystem::remove(folder.path / "b.vol");
+  REQUIRE(manifest.remove_stale().size() == 1);
+  REQUIRE(!std::filesystem::exists(destination / "c.bin"));
+  REQUIRE(std::filesystem::exists(destination / "a.bin"));
+}
@@ -0,0 +1,445 @@
+#include <map>
+#include <fstream>
+#include <algorithm>
+#include "extraction_scheduler.hpp"
+#include "xxhash64.hpp"
+
+namespace studio::resources
+{
+  std::size_t extraction_scheduler::write_task::size() const
+  {
+    return view.size() + contents.size();
+  }
+
+  extraction_scheduler::extraction_scheduler(const resource_explorer& explorer, std::filesystem::path destination, extraction_options options)
+    : explorer(explorer), destination(std::move(destination)), options(options)
+  {
+  }
+
+  extraction_scheduler::~extraction_scheduler()
+  {
+    cancel();
+    wait();
+  }
+
+  void extraction_scheduler::add_files(const std::vector<file_info>& files)
+  {
+    add_files(explorer, files);
+  }
+
+  void extraction_scheduler::add_files(const resource_explorer& source, const std::vector<file_info>& files)
+  {
+    if (started)
+    {
+      throw std::invalid_argument("Files cannot be added once extraction has started.");
+    }
+
+    std::map<std::filesystem::path, std::vector<file_info>> groups;
+
+    for (auto& file : files)
+    {
+      groups[resource_explorer::get_archive_path(file.folder_path)].emplace_back(file);
+      total_bytes += file.size;
+    }
+
+    total_files += files.size();
+
+    for (auto& [archive_path, group] : groups)
+    {
+      // Reading an archive front to back keeps the disk reading ahead instead of seeking.
+      std::stable_sort(group.begin(), group.end(), [](const auto& a, const auto& b) {
+        return a.offset < b.offset;
+      });
+
+      archives.emplace_back(archive_job{ &source, archive_path, std::move(group), {} });
+    }
+  }
+
+  void extraction_scheduler::start()
+  {
+    if (started.exchange(true))
+    {
+      return;
+    }
+
+    auto reader_count = std::min(std::max<std::size_t>(options.reader_count, 1), std::max<std::size_t>(archives.size(), 1));
+    auto writer_count = std::max<std::size_t>(options.writer_count, 1);
+
+    try
+    {
+      if (options.target == extraction_target::tar)
+      {
+        // A tar file is written front to back, so a single writer appends whatever the readers have decompressed.
+        writer_count = 1;
+
+        if (destination.has_parent_path())
+        {
+          std::filesystem::create_directories(destination.parent_path());
+        }
+
+        tar_file = std::make_unique<std::basic_ofstream<std::byte>>(destination, std::ios::binary | std::ios::trunc);
+
+        if (!*tar_file)
+        {
+          add_error("Could not create " + destination.string());
+          cancelled = true;
+        }
+
+        tar = std::make_unique<tar_writer>(*tar_file);
+      }
+      else if (options.incremental)
+      {
+        std::filesystem::create_directories(destination);
+        manifest = std::make_unique<extraction_manifest>(destination);
+      }
+    }
+    catch (const std::exception& ex)
+    {
+      // No worker has started yet, so the run ends here with the reason.
+      fail(ex.what());
+      return;
+    }
+
+    active_readers = reader_count;
+    active_writers = writer_count;
+    running_workers = reader_count + writer_count;
+
+    workers.reserve(reader_count + writer_count);
+
+    for (auto i = 0u; i < reader_count; ++i)
+    {
+      workers.emplace_back([this] { read_archives(); });
+    }
+
+    for (auto i = 0u; i < writer_count; ++i)
+    {
+      workers.emplace_back([this] { write_files(); });
+    }
+  }
+
+  void extraction_scheduler::cancel()
+  {
+    cancelled = true;
+
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    queue_not_full.notify_all();
+    queue_not_empty.notify_all();
+  }
+
+  void extraction_scheduler::fail(std::string message)
+  {
+    add_error(std::move(message));
+    cancel();
+  }
+
+  void extraction_scheduler::wait()
+  {
+    for (auto& worker : workers)
+    {
+      if (worker.joinable())
+      {
+        worker.join();
+      }
+    }
+  }
+
+  extraction_progress extraction_scheduler::get_progress() const
+  {
+    extraction_progress result{};
+    result.total_files = total_files;
+    result.extracted_files = extracted_files;
+    result.failed_files = failed_files;
+    result.skipped_files = skipped_files;
+    result.removed_files = removed_files;
+    result.total_bytes = total_bytes;
+    result.extracted_bytes = extracted_bytes;
+    // Nothing is left to wait for once a run is cancelled, even if it never got as far as starting.
+    result.finished = (started || cancelled) && running_workers == 0;
+    result.cancelled = cancelled;
+
+    if (const auto* current = current_file.load(); current != nullptr)
+    {
+      result.current_file = current->folder_path / current->filename;
+    }
+
+    return result;
+  }
+
+  std::vector<std::string> extraction_scheduler::get_errors() const
+  {
+    std::lock_guard<std::mutex> lock(error_mutex);
+    return errors;
+  }
+
+  void extraction_scheduler::read_archives()
+  {
+    for (auto i = next_archive++; i < archives.size() && !cancelled; i = next_archive++)
+    {
+      auto& job = archives[i];
+      std::basic_ifstream<std::byte> archive_file(job.archive_path, std::ios::binary);
+
+      std::error_code error;
+      const auto write_time = std::filesystem::last_write_time(job.archive_path, error);
+      const auto mtime = error ? std::int64_t(0) : to_unix_time(write_time);
+
+      if (manifest)
+      {
+        job.state = extraction_manifest::get_archive_state(job.archive_path);
+      }
+
+      for (auto& info : job.files)
+      {
+        if (cancelled)
+        {
+          break;
+        }
+
+        try
+        {
+          write_task task{ &info, {}, mtime, &job, 0, {}, {} };
+
+          if (tar)
+          {
+            // Entries are named relative to the root of the tar file.
+            task.file_path = job.explorer->get_extraction_folder({}, info) / info.filename;
+          }
+          else
+          {
+            auto folder = job.explorer->get_extraction_folder(destination, info);
+
+            {
+              // Creating the same folders from several threads at once is not reliable with every standard library.
+              std::lock_guard<std::mutex> lock(folder_mutex);
+
+              if (folders.insert(folder).second)
+              {
+                std::filesystem::create_directories(folder);
+              }
+            }
+
+            task.file_path = folder / info.filename;
+
+            if (manifest && manifest->is_unchanged(task.file_path, job.archive_path, job.state, info.size))
+            {
+              skipped_files++;
+              continue;
+            }
+          }
+
+          if (auto view = job.explorer->get_file_view(info); view.has_value())
+          {
+            task.view = view.value();
+          }
+          else
+          {
+            task.contents.reserve(info.size);
+            blob_stream output(task.contents);
+            job.explorer->extract_file_contents(archive_file, info, output);
+          }
+
+          if (manifest)
+          {
+            // The archive has changed, but most of its entries usually have not.
+            task.hash = xxhash64(task.view.empty() ? nonstd::span<const std::byte>(task.contents.data(), task.contents.size()) : task.view);
+          }
+
+          if (manifest && manifest->has_contents(task.file_path, job.archive_path, job.state, info.size, task.hash))
+          {
+            skipped_files++;
+          }
+          else
+          {
+            push(std::move(task));
+          }
+        }
+        catch (const std::exception& ex)
+        {
+          add_error(info, ex.what());
+        }
+
+        archive_file.clear();
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      active_readers--;
+      queue_not_empty.notify_all();
+    }
+
+    running_workers--;
+  }
+
+  void extraction_scheduler::write_files()
+  {
+    while (auto task = pop())
+    {
+      current_file = task->info;
+
+      if (tar)
+      {
+        write_to_tar(task.value());
+        continue;
+      }
+
+      std::basic_ofstream<std::byte> output(task->file_path, std::ios::binary);
+
+      if (!task->view.empty())
+      {
+        output.write(task->view.data(), std::streamsize(task->view.size()));
+      }
+      else
+      {
+        output.write(task->contents.data(), std::streamsize(task->contents.size()));
+      }
+
+      output.close();
+
+      if (!output)
+      {
+        add_error(*task->info, "Could not write " + task->file_path.string());
+        continue;
+      }
+
+      if (manifest)
+      {
+        manifest->add(task->file_path, task->job->archive_path, task->job->state, task->info->size, task->hash);
+      }
+
+      extracted_files++;
+      extracted_bytes += task->info->size;
+    }
+
+    if (tar)
+    {
+      finish_tar();
+    }
+
+    if (--active_writers == 0 && manifest)
+    {
+      {
+        // Once cancelled, the writers stop without waiting on the readers, which may still be checking the manifest.
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        queue_not_empty.wait(lock, [&] { return active_readers == 0; });
+      }
+
+      finish_manifest();
+    }
+
+    running_workers--;
+  }
+
+  void extraction_scheduler::write_to_tar(const write_task& task)
+  {
+    auto contents = task.view.empty() ? nonstd::span<const std::byte>(task.contents.data(), task.contents.size()) : task.view;
+
+    tar->add_file(task.file_path, contents, task.mtime);
+
+    if (!*tar_file)
+    {
+      add_error(*task.info, "Could not write to " + destination.string());
+      cancel();
+      return;
+    }
+
+    extracted_files++;
+    extracted_bytes += task.info->size;
+  }
+
+  void extraction_scheduler::finish_tar()
+  {
+    if (cancelled)
+    {
+      // Half an archive is of no use to anyone, so it is not left behind.
+      tar_file->close();
+      std::error_code error;
+      std::filesystem::remove(destination, error);
+      return;
+    }
+
+    tar->finish();
+    tar_file->close();
+
+    if (!*tar_file)
+    {
+      add_error("Could not write to " + destination.string());
+    }
+  }
+
+  void extraction_scheduler::finish_manifest()
+  {
+    // A cancelled run has not seen every file, so nothing it missed can be called stale.
+    if (options.remove_stale && !cancelled)
+    {
+      removed_files += manifest->remove_stale().size();
+    }
+
+    try
+    {
+      manifest->save();
+    }
+    catch (const std::exception& ex)
+    {
+      add_error(ex.what());
+    }
+  }
+
+  void extraction_scheduler::push(write_task task)
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+
+    // An entry larger than the whole queue still goes through, on its own.
+    queue_not_full.wait(lock, [&] {
+      return cancelled || queue.empty() || queued_bytes + task.size() <= options.queue_capacity_in_bytes;
+    });
+
+    if (cancelled)
+    {
+      return;
+    }
+
+    queued_bytes += task.size();
+    queue.emplace_back(std::move(task));
+    queue_not_empty.notify_one();
+  }
+
+  std::optional<extraction_scheduler::write_task> extraction_scheduler::pop()
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+
+    queue_not_empty.wait(lock, [&] {
+      return cancelled || !queue.empty() || active_readers == 0;
+    });
+
+    if (cancelled || queue.empty())
+    {
+      return std::nullopt;
+    }
+
+    auto result = std::move(queue.front());
+    queue.pop_front();
+    queued_bytes -= result.size();
+    queue_not_full.notify_all();
+
+    return result;
+  }
+
+  void extraction_scheduler::add_error(const file_info& info, std::string_view message)
+  {
+    failed_files++;
+
+    if (manifest)
+    {
+      manifest->mark_failed(resource_explorer::get_archive_path(info.folder_path));
+    }
+
+    std::lock_guard<std::mutex> lock(error_mutex);
+    errors.emplace_back((info.folder_path / info.filename).string() + ": " + std::string(message));
+  }
+
+  void extraction_scheduler::add_error(std::string message)
+  {
+    std::lock_guard<std::mutex> lock(error_mutex);
+    errors.emplace_back(std::move(message));
+  }
+}// namespace studio::resources
@@ -0,0 +1,174 @@
+#ifndef DARKSTARDTSCONVERTER_EXTRACTION_SCHEDULER_HPP
+#define DARKSTARDTSCONVERTER_EXTRACTION_SCHEDULER_HPP
+
+#include <set>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <optional>
+#include <filesystem>
+#include <condition_variable>
+#include <nonstd/span.hpp>
+#include "resource_explorer.hpp"
+#include "tar_writer.hpp"
+#include "extraction_manifest.hpp"
+
+namespace studio::resources
+{
+  enum class extraction_target
+  {
+    folders,
+    tar
+  };
+
+  struct extraction_options
+  {
+    // Each reader works through one archive at a time, in the order its entries are stored.
+    std::size_t reader_count = 2;
+    std::size_t writer_count = 2;
+    // Readers wait once this many bytes are read but not yet written.
+    std::size_t queue_capacity_in_bytes = 64 * 1024 * 1024;
+    // With tar, the destination is a single tar file which receives every entry, from a single writer.
+    // Each reader adds the entries of its archive in the order they are stored, so with one reader the whole file comes out in that order.
+    extraction_target target = extraction_target::folders;
+    // Keeps a manifest in the destination folder, and only writes the files which are new or have changed since the last run.
+    bool incremental = false;
+    // With incremental, deletes the files of earlier runs which are not part of this one.
+    bool remove_stale = false;
+  };
+
+  struct extraction_progress
+  {
+    std::size_t total_files;
+    std::size_t extracted_files;
+    std::size_t failed_files;
+    // Files which were already up to date in the destination.
+    std::size_t skipped_files;
+    std::size_t removed_files;
+    std::uint64_t total_bytes;
+    std::uint64_t extracted_bytes;
+    // The entry most recently handed to a writer.
+    std::filesystem::path current_file;
+    bool finished;
+    bool cancelled;
+  };
+
+  // Extracts the entries of any number of archives into a destination folder.
+  // Readers go through each archive by offset and queue up the contents of each entry, and writers turn them into files.
+  // Progress is kept in atomics, so that a UI can poll it at its own pace without holding up the workers.
+  class extraction_scheduler
+  {
+  public:
+    extraction_scheduler(const resource_explorer& explorer, std::filesystem::path destination, extraction_options options = {});
+    ~extraction_scheduler();
+
+    extraction_scheduler(const extraction_scheduler&) = delete;
+    extraction_scheduler(extraction_scheduler&&) = delete;
+    extraction_scheduler& operator=(const extraction_scheduler&) = delete;
+    extraction_scheduler& operator=(extraction_scheduler&&) = delete;
+
+    // Files can only be added before the scheduler starts.
+    void add_files(const std::vector<file_info>& files);
+
+    // Adds files found by another explorer, whose paths are then made relative to its search path rather than this one's.
+    void add_files(const resource_explorer& source, const std::vector<file_info>& files);
+
+    void start();
+
+    // Stops the workers after the entries they are working on, leaving the rest unextracted.
+    void cancel();
+
+    // Gives up on an extraction which could not be set up, recording why. The run counts as finished, whether or not it was started.
+    void fail(std::string message);
+
+    void wait();
+
+    extraction_progress get_progress() const;
+
+    std::vector<std::string> get_errors() const;
+
+  private:
+    struct archive_job
+    {
+      const resource_explorer* explorer;
+      std::filesystem::path archive_path;
+      std::vector<file_info> files;
+      archive_state state;
+    };
+
+    struct write_task
+    {
+      const file_info* info;
+      std::filesystem::path file_path;
+      std::int64_t mtime;
+      const archive_job* job;
+      std::uint64_t hash;
+      // Uncompressed entries are written straight from the mapped archive, everything else from contents.
+      nonstd::span<const std::byte> view;
+      blob contents;
+
+      std::size_t size() const;
+    };
+
+    void read_archives();
+    void write_files();
+
+    void push(write_task task);
+    std::optional<write_task> pop();
+
+    void add_error(const file_info& info, std::string_view message);
+    void add_error(std::string message);
+
+    void write_to_tar(const write_task& task);
+    void finish_tar();
+
+    void finish_manifest();
+
+    const resource_explorer& explorer;
+    std::filesystem::path destination;
+    extraction_options options;
+
+    std::vector<archive_job> archives;
+    std::atomic<std::size_t> next_archive = 0;
+
+    std::mutex folder_mutex;
+    std::set<std::filesystem::path> folders;
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_not_full;
+    std::condition_variable queue_not_empty;
+    std::deque<write_task> queue;
+    std::size_t queued_bytes = 0;
+    std::size_t active_readers = 0;
+
+    std::atomic<std::size_t> total_files = 0;
+    std::atomic<std::uint64_t> total_bytes = 0;
+    std::atomic<std::size_t> extracted_files = 0;
+    std::atomic<std::uint64_t> extracted_bytes = 0;
+    std::atomic<std::size_t> failed_files = 0;
+    std::atomic<std::size_t> skipped_files = 0;
+    std::atomic<std::size_t> removed_files = 0;
+    std::atomic<const file_info*> current_file = nullptr;
+    std::atomic<std::size_t> running_workers = 0;
+    std::atomic<std::size_t> active_writers = 0;
+    std::atomic<bool> started = false;
+    std::atomic<bool> cancelled = false;
+
+    mutable std::mutex error_mutex;
+    std::vector<std::string> errors;
+
+    std::unique_ptr<std::basic_ofstream<std::byte>> tar_file;
+    std::unique_ptr<tar_writer> tar;
+
+    std::unique_ptr<extraction_manifest> manifest;
+
+    std::vector<std::thread> workers;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_EXTRACTION_SCHEDULER_HPP
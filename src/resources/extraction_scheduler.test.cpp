@@ -0,0 +1,215 @@
+#include <catch2/catch.hpp>
+#include <stdexcept>
+#include "extraction_scheduler.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+namespace
+{
+  struct failing_vol_archive : studio::resources::vol::darkstar::vol_file_archive
+  {
+    void extract_file_contents(std::basic_istream<std::byte>& stream, const studio::resources::file_info& info, std::basic_ostream<std::byte>& output) const override
+    {
+      if (info.filename == "hiss.sfx")
+      {
+        throw std::invalid_argument("The entry is damaged.");
+      }
+
+      vol_file_archive::extract_file_contents(stream, info, output);
+    }
+  };
+}
+
+TEST_CASE("The extraction scheduler writes every entry of every archive", "[resources.extraction_scheduler]")
+{
+  temp_folder folder("3space-scheduler-test");
+  auto destination = folder.path / "out";
+
+  write_darkstar_vol(folder.path / "shapes.vol", { { "larmor.dts", "shape data" }, { "tribes.ppl", "pppppppppppppppppppppppppppppppppalette", studio::resources::compression_type::rle } });
+  write_darkstar_vol(folder.path / "sounds.vol", { { "boom.sfx", "boom" }, { "hiss.sfx", "hiss" }, { "zap.sfx", "zap!!" } });
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  auto files = explorer.find_files({ "ALL" });
+  REQUIRE(files.size() == 5);
+
+  auto read_output = [&](std::filesystem::path path) {
+    std::basic_ifstream<std::byte> file(destination / path, std::ios::binary);
+    return to_string(file);
+  };
+
+  SECTION("All entries are extracted through a small queue")
+  {
+    studio::resources::extraction_options options{};
+    options.writer_count = 1;
+    options.queue_capacity_in_bytes = 8;
+
+    studio::resources::extraction_scheduler scheduler(explorer, destination, options);
+    scheduler.add_files(files);
+    scheduler.start();
+    scheduler.wait();
+
+    auto progress = scheduler.get_progress();
+    REQUIRE(progress.finished);
+    REQUIRE_FALSE(progress.cancelled);
+    REQUIRE(progress.total_files == 5);
+    REQUIRE(progress.extracted_files == 5);
+    REQUIRE(progress.failed_files == 0);
+    REQUIRE(progress.extracted_bytes == progress.total_bytes);
+    REQUIRE(scheduler.get_errors().empty());
+
+    REQUIRE(read_output("shapes/larmor.dts") == "shape data");
+    REQUIRE(read_output("shapes/tribes.ppl") == "pppppppppppppppppppppppppppppppppalette");
+    REQUIRE(read_output("sounds/zap.sfx") == "zap!!");
+  }
+
+  SECTION("All entries can go into a single tar file instead")
+  {
+    studio::resources::extraction_options options{};
+    options.target = studio::resources::extraction_target::tar;
+    options.reader_count = 1;
+
+    studio::resources::extraction_scheduler scheduler(explorer, destination / "volumes.tar", options);
+    scheduler.add_files(files);
+    scheduler.start();
+    scheduler.wait();
+
+    REQUIRE(scheduler.get_progress().extracted_files == 5);
+    REQUIRE(scheduler.get_errors().empty());
+    REQUIRE_FALSE(std::filesystem::exists(destination / "shapes"));
+
+    // Each header is followed by the contents of its entry, padded to a whole block.
+    const auto archive = read_output("volumes.tar");
+    std::vector<std::pair<std::string, std::string>> entries;
+
+    for (std::size_t position = 0; position < archive.size() && archive[position] != '\0';)
+    {
+      const auto size = std::stoul(archive.substr(position + 124, 11), nullptr, 8);
+      entries.emplace_back(archive.substr(position, archive.find('\0', position) - position), archive.substr(position + 512, size));
+      position += 512 + (size + 511) / 512 * 512;
+    }
+
+    REQUIRE(entries.size() == 5);
+    REQUIRE(entries[0] == std::make_pair(std::string("shapes/larmor.dts"), std::string("shape data")));
+    REQUIRE(entries[1] == std::make_pair(std::string("shapes/tribes.ppl"), std::string("pppppppppppppppppppppppppppppppppalette")));
+    REQUIRE(entries[4] == std::make_pair(std::string("sounds/zap.sfx"), std::string("zap!!")));
+    REQUIRE(archive.size() % 512 == 0);
+  }
+
+  SECTION("Incremental runs only write the files which have changed")
+  {
+    studio::resources::extraction_options options{};
+    options.incremental = true;
+    options.remove_stale = true;
+
+    auto extract = [&](const std::filesystem::path& search_path) {
+      studio::resources::resource_explorer source(search_path);
+      source.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+      studio::resources::extraction_scheduler scheduler(source, destination, options);
+      scheduler.add_files(source.find_files(folder.path / "shapes.vol", { "ALL" }));
+      scheduler.add_files(source.find_files(folder.path / "sounds.vol", { "ALL" }));
+      scheduler.start();
+      scheduler.wait();
+
+      REQUIRE(scheduler.get_errors().empty());
+      return scheduler.get_progress();
+    };
+
+    REQUIRE(extract(folder.path).extracted_files == 5);
+    REQUIRE(std::filesystem::exists(destination / ".3space-manifest"));
+
+    auto progress = extract(folder.path);
+    REQUIRE(progress.extracted_files == 0);
+    REQUIRE(progress.skipped_files == 5);
+
+    // A patch changes one sound and drops another, so the other entries of the volume have to be hashed to tell they are the same.
+    write_darkstar_vol(folder.path / "sounds.vol", { { "boom.sfx", "BOOM" }, { "hiss.sfx", "hiss" } });
+
+    progress = extract(folder.path);
+    REQUIRE(progress.extracted_files == 1);
+    REQUIRE(progress.skipped_files == 3);
+    REQUIRE(progress.removed_files == 1);
+    REQUIRE(read_output("sounds/boom.sfx") == "BOOM");
+    REQUIRE(read_output("shapes/larmor.dts") == "shape data");
+    REQUIRE_FALSE(std::filesystem::exists(destination / "sounds" / "zap.sfx"));
+  }
+
+  SECTION("Files from an archive with a failed entry are not removed as stale")
+  {
+    studio::resources::extraction_options options{};
+    options.incremental = true;
+    options.remove_stale = true;
+
+    {
+      studio::resources::extraction_scheduler scheduler(explorer, destination, options);
+      scheduler.add_files(files);
+      scheduler.start();
+      scheduler.wait();
+      REQUIRE(scheduler.get_progress().extracted_files == 5);
+    }
+
+    write_darkstar_vol(folder.path / "sounds.vol", { { "boom.sfx", "BOOM" }, { "hiss.sfx", "hisssssssss", studio::resources::compression_type::rle } });
+
+    studio::resources::resource_explorer source(folder.path);
+    source.add_archive_type(".vol", std::make_unique<failing_vol_archive>());
+
+    studio::resources::extraction_scheduler scheduler(source, destination, options);
+    scheduler.add_files(source.find_files(folder.path / "sounds.vol", { "ALL" }));
+    scheduler.start();
+    scheduler.wait();
+
+    auto progress = scheduler.get_progress();
+    REQUIRE(progress.failed_files == 1);
+    REQUIRE(progress.removed_files == 0);
+    REQUIRE(read_output("sounds/boom.sfx") == "BOOM");
+    REQUIRE(read_output("sounds/hiss.sfx") == "hiss");
+  }
+
+  SECTION("Cancelled extractions stop without writing anything more")
+  {
+    studio::resources::extraction_scheduler scheduler(explorer, destination);
+    scheduler.add_files(files);
+    scheduler.cancel();
+    scheduler.start();
+    scheduler.wait();
+
+    auto progress = scheduler.get_progress();
+    REQUIRE(progress.finished);
+    REQUIRE(progress.cancelled);
+    REQUIRE(progress.extracted_files == 0);
+    REQUIRE_THROWS_AS(scheduler.add_files(files), std::invalid_argument);
+  }
+
+  SECTION("Destinations which cannot be created end the run with an error")
+  {
+    std::ofstream(folder.path / "file.txt") << "in the way";
+
+    studio::resources::extraction_options options{};
+    options.incremental = true;
+
+    studio::resources::extraction_scheduler scheduler(explorer, folder.path / "file.txt" / "out", options);
+    scheduler.add_files(files);
+    REQUIRE_NOTHROW(scheduler.start());
+    scheduler.wait();
+
+    auto progress = scheduler.get_progress();
+    REQUIRE(progress.finished);
+    REQUIRE(progress.extracted_files == 0);
+    REQUIRE(scheduler.get_errors().size() == 1);
+  }
+
+  SECTION("Extractions which fail before starting still finish")
+  {
+    studio::resources::extraction_scheduler scheduler(explorer, destination);
+    scheduler.fail("The volumes could not be listed.");
+
+    auto progress = scheduler.get_progress();
+    REQUIRE(progress.finished);
+    REQUIRE(progress.cancelled);
+    REQUIRE(scheduler.get_errors() == std::vector<std::string>{ "The volumes could not be listed." });
+  }
+}
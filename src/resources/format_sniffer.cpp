@@ -0,0 +1,57 @@
+#include <fstream>
+#include "format_sniffer.hpp"
+
+namespace studio::resources
+{
+  std::optional<file_stamp> get_file_stamp(const std::filesystem::path& file_path)
+  {
+    std::error_code error;
+    const auto size = std::filesystem::file_size(file_path, error);
+
+    if (error)
+    {
+      return std::nullopt;
+    }
+
+    const auto last_write_time = std::filesystem::last_write_time(file_path, error);
+
+    if (error)
+    {
+      return std::nullopt;
+    }
+
+    return file_stamp{ std::uint64_t(size), std::int64_t(last_write_time.time_since_epoch().count()) };
+  }
+
+  header_prefix::header_prefix(std::basic_istream<std::byte>& stream)
+  {
+    const auto start = stream.tellg();
+
+    if (start == std::streampos(-1))
+    {
+      return;
+    }
+
+    stream.read(bytes.data(), std::streamsize(bytes.size()));
+    size = std::size_t(stream.gcount());
+
+    stream.clear();
+    stream.seekg(start, std::ios::beg);
+  }
+
+  header_prefix::header_prefix(const std::filesystem::path& file_path)
+  {
+    std::basic_ifstream<std::byte> stream(file_path, std::ios::binary);
+
+    if (stream.is_open())
+    {
+      stream.read(bytes.data(), std::streamsize(bytes.size()));
+      size = std::size_t(stream.gcount());
+    }
+  }
+
+  nonstd::span<const std::byte> header_prefix::data() const
+  {
+    return nonstd::span<const std::byte>(bytes.data(), size);
+  }
+}// namespace studio::resources
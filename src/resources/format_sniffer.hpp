@@ -0,0 +1,99 @@
+#ifndef DARKSTARDTSCONVERTER_FORMAT_SNIFFER_HPP
+#define DARKSTARDTSCONVERTER_FORMAT_SNIFFER_HPP
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <optional>
+#include <istream>
+#include <filesystem>
+#include <nonstd/span.hpp>
+#include "archive_plugin.hpp"
+#include "mapped_file.hpp"
+
+namespace studio::resources
+{
+  // Large enough for every header check in the project, the longest of which reads 20 bytes.
+  constexpr std::size_t header_prefix_size = 64;
+
+  struct file_stamp
+  {
+    std::uint64_t size;
+    std::int64_t last_write_time;
+
+    bool operator==(const file_stamp& other) const
+    {
+      return size == other.size && last_write_time == other.last_write_time;
+    }
+  };
+
+  std::optional<file_stamp> get_file_stamp(const std::filesystem::path& file_path);
+
+  // The first bytes of a file, read once so that any number of header checks can run against them.
+  class header_prefix
+  {
+  public:
+    // Leaves the stream at the position it was in before.
+    explicit header_prefix(std::basic_istream<std::byte>& stream);
+    explicit header_prefix(const std::filesystem::path& file_path);
+
+    nonstd::span<const std::byte> data() const;
+
+    template<typename Validator>
+    bool matches(Validator&& validator) const
+    {
+      span_stream stream(data());
+      return validator(stream);
+    }
+
+  private:
+    std::array<std::byte, header_prefix_size> bytes{};
+    std::size_t size = 0;
+  };
+
+  // Formats detected for files, which stay valid for as long as the file they came from is unchanged.
+  // The key is the file itself, while the source is the file on disk holding it, such as its archive.
+  template<typename Format>
+  class format_cache
+  {
+  public:
+    std::optional<Format> find(const std::filesystem::path& key, const std::filesystem::path& source_path) const
+    {
+      auto stamp = get_file_stamp(source_path);
+
+      if (!stamp.has_value())
+      {
+        return std::nullopt;
+      }
+
+      std::shared_lock<std::shared_mutex> lock(mutex);
+
+      if (auto existing = formats.find(key); existing != formats.end() && existing->second.first == stamp.value())
+      {
+        return existing->second.second;
+      }
+
+      return std::nullopt;
+    }
+
+    void insert(const std::filesystem::path& key, const std::filesystem::path& source_path, Format format)
+    {
+      auto stamp = get_file_stamp(source_path);
+
+      if (!stamp.has_value())
+      {
+        return;
+      }
+
+      std::unique_lock<std::shared_mutex> lock(mutex);
+      formats.insert_or_assign(key, std::make_pair(stamp.value(), std::move(format)));
+    }
+
+  private:
+    mutable std::shared_mutex mutex;
+    std::map<std::filesystem::path, std::pair<file_stamp, Format>> formats;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_FORMAT_SNIFFER_HPP
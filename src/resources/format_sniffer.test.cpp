@@ -0,0 +1,48 @@
+#include <catch2/catch.hpp>
+#include "format_sniffer.hpp"
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+namespace
+{
+  struct counting_header_archive : studio::resources::vol::darkstar::vol_file_archive
+  {
+    inline static int check_count = 0;
+
+    bool stream_is_supported(std::basic_istream<std::byte>& stream) const override
+    {
+      check_count++;
+      return vol_file_archive::stream_is_supported(stream);
+    }
+  };
+}
+
+TEST_CASE("Archive formats are detected once per archive until it changes", "[resources.format_sniffer]")
+{
+  temp_folder folder("3space-sniff-test");
+  auto volume_path = folder.path / "shapes.vol";
+  auto text_path = folder.path / "readme.vol";
+
+  write_darkstar_vol(volume_path, { { "larmor.dts", "shape data" } });
+  std::ofstream(text_path) << "not a volume";
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<counting_header_archive>());
+
+  counting_header_archive::check_count = 0;
+
+  REQUIRE(explorer.get_archive_type(volume_path).has_value());
+  REQUIRE(explorer.get_archive_type(volume_path).has_value());
+  REQUIRE_FALSE(explorer.get_archive_type(text_path).has_value());
+  REQUIRE_FALSE(explorer.get_archive_type(text_path).has_value());
+  REQUIRE_FALSE(explorer.get_archive_type(folder.path / "missing.vol").has_value());
+  REQUIRE(counting_header_archive::check_count == 3);
+
+  write_darkstar_vol(volume_path, { { "larmor.dts", "shape data" }, { "tribes.ppl", "palette" } });
+
+  REQUIRE(explorer.get_archive_type(volume_path).has_value());
+  REQUIRE(counting_header_archive::check_count == 4);
+}
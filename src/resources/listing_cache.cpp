@@ -0,0 +1,37 @@
+#include <functional>
+#include "listing_cache.hpp"
+
+namespace studio::resources
+{
+  const listing_cache::shard& listing_cache::get_shard(const std::string& key) const
+  {
+    return shards[std::hash<std::string>{}(key) % shard_count];
+  }
+
+  listing_cache::shard& listing_cache::get_shard(const std::string& key)
+  {
+    return shards[std::hash<std::string>{}(key) % shard_count];
+  }
+
+  std::optional<std::vector<file_info>> listing_cache::find(const std::string& key) const
+  {
+    auto& shard = get_shard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    if (auto existing = shard.listings.find(key); existing != shard.listings.end())
+    {
+      return existing->second.get_files();
+    }
+
+    return std::nullopt;
+  }
+
+  void listing_cache::insert(const std::string& key, const std::vector<file_info>& files)
+  {
+    entry_table table(files);
+
+    auto& shard = get_shard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.listings.emplace(key, std::move(table));
+  }
+}// namespace studio::resources
@@ -0,0 +1,42 @@
+#ifndef DARKSTARDTSCONVERTER_LISTING_CACHE_HPP
+#define DARKSTARDTSCONVERTER_LISTING_CACHE_HPP
+
+#include <map>
+#include <array>
+#include <string>
+#include <vector>
+#include <optional>
+#include <mutex>
+#include <shared_mutex>
+#include "archive_plugin.hpp"
+#include "entry_table.hpp"
+
+namespace studio::resources
+{
+  // Results of find_files, shared between threads. The keys are spread over several
+  // independently locked shards, and readers only take shared locks, so they never wait on each other.
+  class listing_cache
+  {
+  public:
+    std::optional<std::vector<file_info>> find(const std::string& key) const;
+
+    // Keeps the first result stored for a key, since every result for the same key is equivalent.
+    void insert(const std::string& key, const std::vector<file_info>& files);
+
+  private:
+    static constexpr std::size_t shard_count = 16;
+
+    struct shard
+    {
+      mutable std::shared_mutex mutex;
+      std::map<std::string, entry_table> listings;
+    };
+
+    const shard& get_shard(const std::string& key) const;
+    shard& get_shard(const std::string& key);
+
+    std::array<shard, shard_count> shards;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_LISTING_CACHE_HPP
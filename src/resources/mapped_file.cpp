@@ -0,0 +1,179 @@
+#include <system_error>
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace studio::resources
+{
+#ifdef _WIN32
+  mapped_file::mapped_file(const std::filesystem::path& path)
+  {
+    file_handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+      file_handle = nullptr;
+      throw std::system_error(int(GetLastError()), std::system_category(), "Could not open " + path.string());
+    }
+
+    LARGE_INTEGER file_size{};
+    GetFileSizeEx(file_handle, &file_size);
+    size = std::size_t(file_size.QuadPart);
+
+    if (size == 0)
+    {
+      return;
+    }
+
+    mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping_handle == nullptr)
+    {
+      CloseHandle(file_handle);
+      throw std::system_error(int(GetLastError()), std::system_category(), "Could not map " + path.string());
+    }
+
+    start = static_cast<const std::byte*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+
+    if (start == nullptr)
+    {
+      // The error is taken before closing anything, since CloseHandle can replace it.
+      const auto error = int(GetLastError());
+      CloseHandle(mapping_handle);
+      CloseHandle(file_handle);
+      throw std::system_error(error, std::system_category(), "Could not map a view of " + path.string());
+    }
+  }
+
+  mapped_file::~mapped_file()
+  {
+    if (start != nullptr)
+    {
+      UnmapViewOfFile(start);
+    }
+
+    if (mapping_handle != nullptr)
+    {
+      CloseHandle(mapping_handle);
+    }
+
+    if (file_handle != nullptr)
+    {
+      CloseHandle(file_handle);
+    }
+  }
+#else
+  mapped_file::mapped_file(const std::filesystem::path& path)
+  {
+    file_descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (file_descriptor == -1)
+    {
+      throw std::system_error(errno, std::generic_category(), "Could not open " + path.string());
+    }
+
+    struct stat file_stats{};
+    fstat(file_descriptor, &file_stats);
+    size = std::size_t(file_stats.st_size);
+
+    if (size == 0)
+    {
+      return;
+    }
+
+    auto* result = mmap(nullptr, size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+
+    if (result == MAP_FAILED)
+    {
+      close(file_descriptor);
+      throw std::system_error(errno, std::generic_category(), "Could not map " + path.string());
+    }
+
+    start = static_cast<const std::byte*>(result);
+  }
+
+  mapped_file::~mapped_file()
+  {
+    if (start != nullptr)
+    {
+      munmap(const_cast<std::byte*>(start), size);
+    }
+
+    if (file_descriptor != -1)
+    {
+      close(file_descriptor);
+    }
+  }
+#endif
+
+  nonstd::span<const std::byte> mapped_file::data() const
+  {
+    return nonstd::span<const std::byte>(start, start == nullptr ? 0 : size);
+  }
+
+  span_buffer::span_buffer(nonstd::span<const std::byte> data)
+  {
+    auto* begin = const_cast<std::byte*>(data.data());
+    setg(begin, begin, begin + data.size());
+  }
+
+  span_buffer::pos_type span_buffer::seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode)
+  {
+    if (!(mode & std::ios_base::in))
+    {
+      return pos_type(off_type(-1));
+    }
+
+    off_type base = 0;
+
+    if (direction == std::ios_base::cur)
+    {
+      base = gptr() - eback();
+    }
+    else if (direction == std::ios_base::end)
+    {
+      base = egptr() - eback();
+    }
+
+    const auto new_position = base + offset;
+
+    if (new_position < 0 || new_position > egptr() - eback())
+    {
+      return pos_type(off_type(-1));
+    }
+
+    setg(eback(), eback() + new_position, egptr());
+    return pos_type(new_position);
+  }
+
+  span_buffer::pos_type span_buffer::seekpos(pos_type position, std::ios_base::openmode mode)
+  {
+    return seekoff(off_type(position), std::ios_base::beg, mode);
+  }
+
+  std::streamsize span_buffer::showmanyc()
+  {
+    const auto remaining = egptr() - gptr();
+    return remaining == 0 ? -1 : remaining;
+  }
+
+  span_stream::span_stream(nonstd::span<const std::byte> data, std::shared_ptr<const void> owner)
+    : std::basic_istream<std::byte>(nullptr), view(data), buffer(data), owner(std::move(owner))
+  {
+    rdbuf(&buffer);
+  }
+
+  nonstd::span<const std::byte> span_stream::data() const
+  {
+    return view;
+  }
+}// namespace studio::resources
@@ -0,0 +1,63 @@
+#ifndef DARKSTARDTSCONVERTER_MAPPED_FILE_HPP
+#define DARKSTARDTSCONVERTER_MAPPED_FILE_HPP
+
+#include <istream>
+#include <memory>
+#include <filesystem>
+#include <nonstd/span.hpp>
+
+namespace studio::resources
+{
+  // Read-only memory mapping of a whole file, which stays valid for the lifetime of the object.
+  class mapped_file
+  {
+  public:
+    explicit mapped_file(const std::filesystem::path& path);
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file(mapped_file&&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    mapped_file& operator=(mapped_file&&) = delete;
+
+    nonstd::span<const std::byte> data() const;
+
+  private:
+    const std::byte* start = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#else
+    int file_descriptor = -1;
+#endif
+  };
+
+  class span_buffer : public std::basic_streambuf<std::byte>
+  {
+  public:
+    explicit span_buffer(nonstd::span<const std::byte> data);
+
+  protected:
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode) override;
+    pos_type seekpos(pos_type position, std::ios_base::openmode mode) override;
+    std::streamsize showmanyc() override;
+  };
+
+  // An input stream over memory owned by someone else, such as a mapped file.
+  // The owner is kept alive for as long as the stream exists.
+  class span_stream : public std::basic_istream<std::byte>
+  {
+  public:
+    explicit span_stream(nonstd::span<const std::byte> data, std::shared_ptr<const void> owner = nullptr);
+
+    nonstd::span<const std::byte> data() const;
+
+  private:
+    nonstd::span<const std::byte> view;
+    span_buffer buffer;
+    std::shared_ptr<const void> owner;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_MAPPED_FILE_HPP
@@ -0,0 +1,51 @@
+#include <catch2/catch.hpp>
+#include <string_view>
+#include "mapped_file.hpp"
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Span streams read and seek within their view", "[resources.mapped_file]")
+{
+  constexpr std::string_view text = "0123456789";
+  auto view = nonstd::span<const std::byte>(reinterpret_cast<const std::byte*>(text.data()), text.size());
+
+  studio::resources::span_stream stream(view.subspan(2, 6));
+
+  REQUIRE(to_string(stream) == "234567");
+
+  stream.clear();
+  stream.seekg(-2, std::ios::end);
+  REQUIRE(stream.tellg() == 4);
+  REQUIRE(to_string(stream) == "67");
+
+  stream.clear();
+  stream.seekg(7, std::ios::beg);
+  REQUIRE(stream.fail());
+}
+
+TEST_CASE("Uncompressed archive entries are loaded from a mapped view", "[resources.explorer]")
+{
+  temp_folder folder("3space-explorer-test");
+  auto volume_path = folder.path / "shapes.vol";
+
+  write_darkstar_vol(volume_path, { { "larmor.dts", "shape data" }, { "tribes.ppl", "palette" } });
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  auto files = explorer.find_files({ "ALL" });
+
+  REQUIRE(files.size() == 2);
+  REQUIRE(files[1].filename == "tribes.ppl");
+
+  auto view = explorer.get_file_view(files[1]);
+  REQUIRE(view.has_value());
+  REQUIRE(std::string_view(reinterpret_cast<const char*>(view->data()), view->size()) == "palette");
+
+  auto [info, stream] = explorer.load_file(files[0]);
+  REQUIRE(dynamic_cast<studio::resources::span_stream*>(stream.get()) != nullptr);
+  REQUIRE(to_string(*stream) == "shape data");
+}
@@ -0,0 +1,125 @@
+#include <map>
+#include <algorithm>
+#include "overlay_index.hpp"
+
+namespace studio::resources
+{
+  overlay_index overlay_index::build(const std::vector<file_info>& files)
+  {
+    // Whether a source is a loose folder is only checked once for each folder.
+    std::map<std::filesystem::path, std::vector<file_info>> volumes;
+    std::map<std::filesystem::path, std::vector<file_info>> folders;
+
+    for (auto& file : files)
+    {
+      if (auto existing = folders.find(file.folder_path); existing != folders.end())
+      {
+        existing->second.emplace_back(file);
+      }
+      else if (auto volume = volumes.find(file.folder_path); volume != volumes.end())
+      {
+        volume->second.emplace_back(file);
+      }
+      else
+      {
+        auto& group = std::filesystem::is_directory(file.folder_path) ? folders[file.folder_path] : volumes[file.folder_path];
+        group.emplace_back(file);
+      }
+    }
+
+    auto by_path = [](const auto& a, const auto& b) {
+      return normalise_path(a->first) < normalise_path(b->first);
+    };
+
+    std::vector<decltype(volumes)::const_iterator> sources;
+    sources.reserve(volumes.size() + folders.size());
+
+    for (auto it = volumes.cbegin(); it != volumes.cend(); ++it)
+    {
+      sources.emplace_back(it);
+    }
+
+    std::sort(sources.begin(), sources.end(), by_path);
+    const auto volume_count = sources.size();
+
+    for (auto it = folders.cbegin(); it != folders.cend(); ++it)
+    {
+      sources.emplace_back(it);
+    }
+
+    std::sort(sources.begin() + std::ptrdiff_t(volume_count), sources.end(), by_path);
+
+    overlay_index result;
+    result.names.reserve(files.size());
+    result.entries.reserve(files.size());
+
+    for (auto& source : sources)
+    {
+      result.add_source(source->second);
+    }
+
+    return result;
+  }
+
+  void overlay_index::add_source(const std::vector<file_info>& files)
+  {
+    for (auto& file : files)
+    {
+      auto [existing, added] = names.emplace(normalise_path(file.filename), entries.size());
+
+      if (added)
+      {
+        entries.emplace_back(overlay_entry{ file, {} });
+        continue;
+      }
+
+      auto& entry = entries[existing->second];
+      entry.shadowed.insert(entry.shadowed.begin(), std::move(entry.winner));
+      entry.winner = file;
+      total_shadowed++;
+    }
+  }
+
+  std::optional<file_info> overlay_index::resolve(const std::filesystem::path& filename) const
+  {
+    if (auto existing = names.find(normalise_path(filename)); existing != names.end())
+    {
+      return entries[existing->second].winner;
+    }
+
+    return std::nullopt;
+  }
+
+  std::vector<file_info> overlay_index::get_shadowed(const std::filesystem::path& filename) const
+  {
+    if (auto existing = names.find(normalise_path(filename)); existing != names.end())
+    {
+      return entries[existing->second].shadowed;
+    }
+
+    return {};
+  }
+
+  std::vector<file_info> overlay_index::get_files() const
+  {
+    std::vector<file_info> results;
+    results.reserve(entries.size());
+
+    for (auto& entry : entries)
+    {
+      results.emplace_back(entry.winner);
+    }
+
+    return results;
+  }
+
+  std::size_t overlay_index::size() const
+  {
+    return entries.size();
+  }
+
+  std::size_t overlay_index::shadowed_count() const
+  {
+    return total_shadowed;
+  }
+}// namespace studio::resources
@@ -0,0 +1,50 @@
+#ifndef DARKSTARDTSCONVERTER_OVERLAY_INDEX_HPP
+#define DARKSTARDTSCONVERTER_OVERLAY_INDEX_HPP
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <filesystem>
+#include "archive_plugin.hpp"
+
+namespace studio::resources
+{
+  // Finds files by their name alone, the way Darkstar games do: every volume and loose folder is searched,
+  // and a file from a source loaded later replaces any file of the same name from a source loaded before it.
+  // The files which lose out are kept too, to help work out why a game picks the file it does.
+  class overlay_index
+  {
+  public:
+    // Orders the files the way the games load them: volumes in path order, then loose files, which override any volume.
+    static overlay_index build(const std::vector<file_info>& files);
+
+    // Adds the files of one volume or folder, which take precedence over every source added before.
+    void add_source(const std::vector<file_info>& files);
+
+    // The file a game would load for filename, ignoring case.
+    std::optional<file_info> resolve(const std::filesystem::path& filename) const;
+
+    // Every other file called filename, starting with the one loaded most recently.
+    std::vector<file_info> get_shadowed(const std::filesystem::path& filename) const;
+
+    // The files which win, one for each name, in the order their names were first seen.
+    std::vector<file_info> get_files() const;
+
+    std::size_t size() const;
+    std::size_t shadowed_count() const;
+
+  private:
+    struct overlay_entry
+    {
+      file_info winner;
+      std::vector<file_info> shadowed;
+    };
+
+    std::unordered_map<std::string, std::size_t> names;
+    std::vector<overlay_entry> entries;
+    std::size_t total_shadowed = 0;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_OVERLAY_INDEX_HPP
@@ -0,0 +1,71 @@
+#include <catch2/catch.hpp>
+#include "overlay_index.hpp"
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Later sources override files of the same name from earlier ones", "[resources.overlay_index]")
+{
+  using studio::resources::file_info;
+
+  studio::resources::overlay_index index;
+  index.add_source({ file_info{ "tribes.ppl", 0, 10, studio::resources::compression_type::none, "base.vol", nullptr, std::nullopt }, file_info{ "larmor.dts", 0, 20, studio::resources::compression_type::none, "base.vol", nullptr, std::nullopt } });
+  index.add_source({ file_info{ "TRIBES.PPL", 0, 30, studio::resources::compression_type::none, "patch.vol", nullptr, std::nullopt } });
+  index.add_source({ file_info{ "Tribes.ppl", 0, 40, studio::resources::compression_type::none, "mods", nullptr, std::nullopt } });
+
+  REQUIRE(index.size() == 2);
+  REQUIRE(index.shadowed_count() == 2);
+
+  auto winner = index.resolve("tribes.PPL");
+  REQUIRE(winner.has_value());
+  REQUIRE(winner->folder_path == "mods");
+
+  auto shadowed = index.get_shadowed("tribes.ppl");
+  REQUIRE(shadowed.size() == 2);
+  REQUIRE(shadowed[0].folder_path == "patch.vol");
+  REQUIRE(shadowed[1].folder_path == "base.vol");
+
+  REQUIRE(index.resolve("larmor.dts")->size == 20);
+  REQUIRE(index.get_shadowed("larmor.dts").empty());
+  REQUIRE_FALSE(index.resolve("missing.dts").has_value());
+
+  auto files = index.get_files();
+  REQUIRE(files.size() == 2);
+  REQUIRE(files[0].filename == "Tribes.ppl");
+}
+
+TEST_CASE("Loose files and later volumes take precedence in the overlay index", "[resources.explorer]")
+{
+  temp_folder folder("3space-overlay-test");
+
+  write_darkstar_vol(folder.path / "a.vol", { { "tribes.ppl", "first" }, { "larmor.dts", "shape" } });
+  write_darkstar_vol(folder.path / "b.vol", { { "TRIBES.PPL", "second" } });
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  auto index = explorer.get_overlay_index({ ".ppl", ".dts" });
+  REQUIRE(index->size() == 2);
+  REQUIRE(explorer.get_overlay_index({ ".ppl", ".dts" }) == index);
+
+  auto winner = index->resolve("tribes.ppl");
+  REQUIRE(winner.has_value());
+  REQUIRE(winner->folder_path == folder.path / "b.vol");
+  REQUIRE(to_string(*explorer.load_file(winner.value()).second) == "second");
+  REQUIRE(index->get_shadowed("tribes.ppl").size() == 1);
+
+  std::ofstream(folder.path / "tribes.ppl", std::ios::binary) << "loose";
+
+  studio::resources::resource_explorer fresh_explorer(folder.path);
+  fresh_explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  index = fresh_explorer.get_overlay_index({ ".ppl" });
+  REQUIRE(index->resolve("Tribes.ppl")->folder_path == folder.path);
+
+  auto shadowed = index->get_shadowed("tribes.ppl");
+  REQUIRE(shadowed.size() == 2);
+  REQUIRE(shadowed[0].folder_path == folder.path / "b.vol");
+  REQUIRE(shadowed[1].folder_path == folder.path / "a.vol");
+}
@@ -0,0 +1,119 @@
+#include <cerrno>
+#include <limits>
+#include <algorithm>
+#include <system_error>
+#include "positional_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace studio::resources
+{
+#ifdef _WIN32
+  positional_file::positional_file(const std::filesystem::path& path)
+  {
+    file_handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+      file_handle = nullptr;
+      throw std::system_error(int(GetLastError()), std::system_category(), "Could not open " + path.string());
+    }
+
+    LARGE_INTEGER size{};
+    GetFileSizeEx(file_handle, &size);
+    file_size = std::uint64_t(size.QuadPart);
+  }
+
+  positional_file::~positional_file()
+  {
+    if (file_handle != nullptr)
+    {
+      CloseHandle(file_handle);
+    }
+  }
+
+  std::size_t positional_file::read(std::uint64_t offset, nonstd::span<std::byte> output) const
+  {
+    std::size_t total = 0;
+
+    while (total < output.size() && offset + total < file_size)
+    {
+      // The offset of each read comes from the OVERLAPPED structure, so the file pointer which other reads would share is never relied on.
+      OVERLAPPED position{};
+      position.Offset = DWORD((offset + total) & 0xFFFFFFFF);
+      position.OffsetHigh = DWORD((offset + total) >> 32);
+
+      const auto count = DWORD(std::min<std::size_t>(output.size() - total, std::numeric_limits<DWORD>::max()));
+      DWORD bytes_read = 0;
+
+      if (!ReadFile(file_handle, output.data() + total, count, &bytes_read, &position) || bytes_read == 0)
+      {
+        break;
+      }
+
+      total += bytes_read;
+    }
+
+    return total;
+  }
+#else
+  positional_file::positional_file(const std::filesystem::path& path)
+  {
+    file_descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (file_descriptor == -1)
+    {
+      throw std::system_error(errno, std::generic_category(), "Could not open " + path.string());
+    }
+
+    struct stat file_stats{};
+    fstat(file_descriptor, &file_stats);
+    file_size = std::uint64_t(file_stats.st_size);
+  }
+
+  positional_file::~positional_file()
+  {
+    if (file_descriptor != -1)
+    {
+      close(file_descriptor);
+    }
+  }
+
+  std::size_t positional_file::read(std::uint64_t offset, nonstd::span<std::byte> output) const
+  {
+    std::size_t total = 0;
+
+    while (total < output.size())
+    {
+      const auto bytes_read = pread(file_descriptor, output.data() + total, output.size() - total, off_t(offset + total));
+
+      if (bytes_read == -1 && errno == EINTR)
+      {
+        continue;
+      }
+
+      if (bytes_read <= 0)
+      {
+        break;
+      }
+
+      total += std::size_t(bytes_read);
+    }
+
+    return total;
+  }
+#endif
+
+  std::uint64_t positional_file::size() const
+  {
+    return file_size;
+  }
+}// namespace studio::resources
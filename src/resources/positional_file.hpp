@@ -0,0 +1,38 @@
+#ifndef DARKSTARDTSCONVERTER_POSITIONAL_FILE_HPP
+#define DARKSTARDTSCONVERTER_POSITIONAL_FILE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <nonstd/span.hpp>
+
+namespace studio::resources
+{
+  // A read-only file which is read at explicit offsets instead of from a current position.
+  // Nothing is changed by a read, so any number of threads can read the same file at once.
+  class positional_file
+  {
+  public:
+    explicit positional_file(const std::filesystem::path& path);
+    ~positional_file();
+
+    positional_file(const positional_file&) = delete;
+    positional_file(positional_file&&) = delete;
+    positional_file& operator=(const positional_file&) = delete;
+    positional_file& operator=(positional_file&&) = delete;
+
+    // Fills as much of output as the file has from offset onwards, and returns how many bytes were read.
+    std::size_t read(std::uint64_t offset, nonstd::span<std::byte> output) const;
+
+    std::uint64_t size() const;
+
+  private:
+    std::uint64_t file_size = 0;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+#else
+    int file_descriptor = -1;
+#endif
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_POSITIONAL_FILE_HPP
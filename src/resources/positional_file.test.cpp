@@ -0,0 +1,91 @@
+#include <catch2/catch.hpp>
+#include <array>
+#include <atomic>
+#include <thread>
+#include "positional_file.hpp"
+#include "range_stream.hpp"
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Entries of one archive can be read by many threads at once", "[resources.positional_file]")
+{
+  temp_folder folder("3space-positional-test");
+  auto volume_path = folder.path / "shapes.vol";
+
+  std::vector<std::string> contents;
+  std::vector<test_entry> entries;
+
+  for (auto i = 0; i < 40; ++i)
+  {
+    contents.emplace_back(std::string(std::size_t(100 + i * 37), char('a' + i % 26)) + std::to_string(i));
+  }
+
+  std::vector<std::string> names;
+
+  for (auto i = 0u; i < contents.size(); ++i)
+  {
+    names.emplace_back("entry" + std::to_string(i) + ".dts");
+  }
+
+  for (auto i = 0u; i < contents.size(); ++i)
+  {
+    entries.emplace_back(test_entry{ names[i], contents[i], i % 3 == 0 ? studio::resources::compression_type::rle : studio::resources::compression_type::none });
+  }
+
+  write_darkstar_vol(volume_path, entries);
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  auto files = explorer.find_files({ "ALL" });
+  REQUIRE(files.size() == contents.size());
+
+  auto expected = [&](const auto& file) {
+    return contents[std::size_t(std::stoi(file.filename.stem().string().substr(5)))];
+  };
+
+  studio::resources::positional_file source(volume_path);
+  studio::resources::vol::darkstar::vol_file_archive plugin;
+  std::atomic<int> mismatches = 0;
+  std::vector<std::thread> threads;
+
+  for (auto t = 0u; t < 8; ++t)
+  {
+    threads.emplace_back([&, t] {
+      for (auto i = 0u; i < files.size(); ++i)
+      {
+        auto& file = files[(i * 7 + t * 5) % files.size()];
+        const auto offset = std::uint64_t(t * 3);
+
+        std::vector<std::byte> output(file.size);
+        const auto bytes_read = plugin.read_entry(source, file, offset, output);
+        const auto through_explorer = explorer.read_entry(file, offset, output);
+
+        const auto text = expected(file).substr(offset);
+
+        if (bytes_read != text.size() || through_explorer != text.size() || std::string(reinterpret_cast<const char*>(output.data()), through_explorer) != text)
+        {
+          mismatches++;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  REQUIRE(mismatches == 0);
+
+  std::array<std::byte, 4> tail{};
+  REQUIRE(plugin.read_entry(source, files[1], files[1].size - 2, tail) == 2);
+  REQUIRE(plugin.read_entry(source, files[1], files[1].size, tail) == 0);
+
+  studio::resources::range_stream stream(source);
+  stream.seekg(0, std::ios::end);
+  REQUIRE(std::uint64_t(stream.tellg()) == source.size());
+}
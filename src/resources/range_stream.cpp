@@ -0,0 +1,168 @@
+#include <algorithm>
+#include "range_stream.hpp"
+
+namespace studio::resources
+{
+  constexpr std::size_t range_buffer_size = 64 * 1024;
+
+  range_buffer::range_buffer(std::basic_istream<std::byte>& parent, std::uint64_t offset, std::uint64_t size)
+    : range_buffer([&parent](std::uint64_t position, char_type* output, std::uint64_t count) {
+        parent.clear();
+        parent.seekg(std::streamoff(position), std::ios::beg);
+        parent.read(output, std::streamsize(count));
+        return std::max(parent.gcount(), std::streamsize(0));
+      },
+      offset,
+      size)
+  {
+  }
+
+  range_buffer::range_buffer(reader read, std::uint64_t offset, std::uint64_t size)
+    : read(std::move(read)), offset(offset), size(size)
+  {
+  }
+
+  std::uint64_t range_buffer::get_position() const
+  {
+    return next - std::uint64_t(egptr() - gptr());
+  }
+
+  std::streamsize range_buffer::read_parent(char_type* output, std::uint64_t count)
+  {
+    count = std::min(count, size - std::min(next, size));
+
+    if (count == 0)
+    {
+      return 0;
+    }
+
+    const auto result = read(offset + next, output, count);
+    next += std::uint64_t(result);
+    return result;
+  }
+
+  range_buffer::int_type range_buffer::underflow()
+  {
+    if (gptr() < egptr())
+    {
+      return traits_type::to_int_type(*gptr());
+    }
+
+    buffer.resize(range_buffer_size);
+    const auto bytes_read = read_parent(buffer.data(), buffer.size());
+
+    if (bytes_read == 0)
+    {
+      setg(nullptr, nullptr, nullptr);
+      return traits_type::eof();
+    }
+
+    setg(buffer.data(), buffer.data(), buffer.data() + bytes_read);
+    return traits_type::to_int_type(*gptr());
+  }
+
+  std::streamsize range_buffer::xsgetn(char_type* output, std::streamsize count)
+  {
+    std::streamsize result = 0;
+
+    if (const auto buffered = std::min<std::streamsize>(count, egptr() - gptr()); buffered > 0)
+    {
+      std::copy_n(gptr(), buffered, output);
+      gbump(int(buffered));
+      result = buffered;
+    }
+
+    // Large reads go straight to the parent, rather than through the buffer.
+    if (count - result >= std::streamsize(range_buffer_size))
+    {
+      setg(nullptr, nullptr, nullptr);
+      return result + read_parent(output + result, std::uint64_t(count - result));
+    }
+
+    if (result < count)
+    {
+      result += std::basic_streambuf<std::byte>::xsgetn(output + result, count - result);
+    }
+
+    return result;
+  }
+
+  range_buffer::pos_type range_buffer::seekoff(off_type new_offset, std::ios_base::seekdir direction, std::ios_base::openmode mode)
+  {
+    if (!(mode & std::ios_base::in))
+    {
+      return pos_type(off_type(-1));
+    }
+
+    off_type base = 0;
+
+    if (direction == std::ios_base::cur)
+    {
+      base = off_type(get_position());
+    }
+    else if (direction == std::ios_base::end)
+    {
+      base = off_type(size);
+    }
+
+    const auto new_position = base + new_offset;
+
+    if (new_position < 0 || std::uint64_t(new_position) > size)
+    {
+      return pos_type(off_type(-1));
+    }
+
+    const auto buffer_start = next - std::uint64_t(egptr() - eback());
+
+    if (eback() != nullptr && std::uint64_t(new_position) >= buffer_start && std::uint64_t(new_position) <= next)
+    {
+      setg(eback(), eback() + (std::uint64_t(new_position) - buffer_start), egptr());
+    }
+    else
+    {
+      setg(nullptr, nullptr, nullptr);
+      next = std::uint64_t(new_position);
+    }
+
+    return pos_type(new_position);
+  }
+
+  range_buffer::pos_type range_buffer::seekpos(pos_type position, std::ios_base::openmode mode)
+  {
+    return seekoff(off_type(position), std::ios_base::beg, mode);
+  }
+
+  std::streamsize range_buffer::showmanyc()
+  {
+    const auto remaining = size - std::min(get_position(), size);
+    return remaining == 0 ? -1 : std::streamsize(remaining);
+  }
+
+  range_stream::range_stream(std::unique_ptr<std::basic_istream<std::byte>> parent, std::uint64_t offset, std::uint64_t size)
+    : std::basic_istream<std::byte>(nullptr), owned_parent(std::move(parent)), buffer(*owned_parent, offset, size)
+  {
+    rdbuf(&buffer);
+  }
+
+  range_stream::range_stream(std::basic_istream<std::byte>& parent, std::uint64_t offset, std::uint64_t size)
+    : std::basic_istream<std::byte>(nullptr), buffer(parent, offset, size)
+  {
+    rdbuf(&buffer);
+  }
+
+  range_stream::range_stream(const positional_file& parent, std::uint64_t offset, std::uint64_t size)
+    : std::basic_istream<std::byte>(nullptr),
+      buffer([&parent](std::uint64_t position, std::byte* output, std::uint64_t count) {
+        return std::streamsize(parent.read(position, nonstd::span<std::byte>(output, std::size_t(count))));
+      },
+      offset,
+      size)
+  {
+    rdbuf(&buffer);
+  }
+
+  range_stream::range_stream(const positional_file& parent)
+    : range_stream(parent, 0, parent.size())
+  {
+  }
+}// namespace studio::resources
@@ -0,0 +1,60 @@
+#ifndef DARKSTARDTSCONVERTER_RANGE_STREAM_HPP
+#define DARKSTARDTSCONVERTER_RANGE_STREAM_HPP
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <istream>
+#include <functional>
+#include "positional_file.hpp"
+
+namespace studio::resources
+{
+  // Exposes size bytes of another stream or file, starting at offset, as a stream of their own.
+  // Positions are relative to the start of the range, and nothing outside of it can be read.
+  class range_buffer : public std::basic_streambuf<std::byte>
+  {
+  public:
+    // Reads count bytes at an absolute position of the parent into output, and returns how many were read.
+    using reader = std::function<std::streamsize(std::uint64_t, char_type*, std::uint64_t)>;
+
+    range_buffer(std::basic_istream<std::byte>& parent, std::uint64_t offset, std::uint64_t size);
+    range_buffer(reader read, std::uint64_t offset, std::uint64_t size);
+
+  protected:
+    int_type underflow() override;
+    std::streamsize xsgetn(char_type* output, std::streamsize count) override;
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode) override;
+    pos_type seekpos(pos_type position, std::ios_base::openmode mode) override;
+    std::streamsize showmanyc() override;
+
+  private:
+    std::uint64_t get_position() const;
+    std::streamsize read_parent(char_type* output, std::uint64_t count);
+
+    reader read;
+    std::uint64_t offset;
+    std::uint64_t size;
+    // Where the next read from the parent starts, relative to offset.
+    std::uint64_t next = 0;
+    std::vector<std::byte> buffer;
+  };
+
+  // An archive entry, or any other part of a stream, read as if it were a file of its own.
+  // The parent can be owned by the range, or belong to someone else and outlive it.
+  // Ranges of a positional_file only keep a position of their own, so any number of them can read the same file at once.
+  class range_stream : public std::basic_istream<std::byte>
+  {
+  public:
+    range_stream(std::unique_ptr<std::basic_istream<std::byte>> parent, std::uint64_t offset, std::uint64_t size);
+    range_stream(std::basic_istream<std::byte>& parent, std::uint64_t offset, std::uint64_t size);
+    range_stream(const positional_file& parent, std::uint64_t offset, std::uint64_t size);
+    explicit range_stream(const positional_file& parent);
+
+  private:
+    std::unique_ptr<std::basic_istream<std::byte>> owned_parent;
+    range_buffer buffer;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_RANGE_STREAM_HPP
@@ -0,0 +1,29 @@
+#include <catch2/catch.hpp>
+#include <array>
+#include <string>
+#include "mapped_file.hpp"
+#include "range_stream.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Range streams only expose their part of the parent stream", "[resources.range_stream]")
+{
+  std::string text = "0123456789";
+  studio::resources::span_stream parent(nonstd::span<const std::byte>(reinterpret_cast<const std::byte*>(text.data()), text.size()));
+
+  studio::resources::range_stream stream(parent, 3, 5);
+  REQUIRE(to_string(stream) == "34567");
+
+  stream.clear();
+  stream.seekg(-2, std::ios::end);
+  REQUIRE(stream.tellg() == 3);
+  REQUIRE(to_string(stream) == "67");
+
+  stream.clear();
+  stream.seekg(1, std::ios::beg);
+  std::array<std::byte, 8> buffer{};
+  stream.read(buffer.data(), buffer.size());
+  REQUIRE(stream.gcount() == 4);
+  REQUIRE(char(buffer[0]) == '4');
+}
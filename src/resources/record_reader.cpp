@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include "record_reader.hpp"
+#include "mapped_file.hpp"
+
+namespace studio::resources
+{
+  std::vector<std::byte> read_records(std::basic_istream<std::byte>& stream, nonstd::span<const std::size_t> offsets, std::size_t record_size)
+  {
+    std::vector<std::byte> results(offsets.size() * record_size, std::byte{});
+
+    if (auto* memory = dynamic_cast<span_stream*>(&stream); memory != nullptr)
+    {
+      const auto view = memory->data();
+
+      for (auto i = 0u; i < offsets.size(); ++i)
+      {
+        if (offsets[i] < view.size())
+        {
+          std::memcpy(results.data() + i * record_size, view.data() + offsets[i], std::min(record_size, view.size() - offsets[i]));
+        }
+      }
+
+      return results;
+    }
+
+    std::vector<std::size_t> order(offsets.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) {
+      return offsets[a] < offsets[b];
+    });
+
+    std::vector<std::byte> block;
+    std::optional<std::size_t> position;
+
+    for (auto first = order.begin(); first != order.end();)
+    {
+      const auto block_start = offsets[*first];
+      auto block_end = block_start + record_size;
+      auto last = first + 1;
+
+      while (last != order.end() && offsets[*last] + record_size - block_start <= std::max(coalesced_read_size, record_size))
+      {
+        block_end = std::max(block_end, offsets[*last] + record_size);
+        ++last;
+      }
+
+      block.resize(block_end - block_start);
+
+      stream.clear();
+
+      if (position != block_start)
+      {
+        stream.seekg(block_start, std::ios::beg);
+      }
+
+      stream.read(block.data(), std::streamsize(block.size()));
+      const auto bytes_read = std::size_t(std::max(stream.gcount(), std::streamsize(0)));
+      position = block_start + bytes_read;
+
+      for (; first != last; ++first)
+      {
+        const auto start = offsets[*first] - block_start;
+
+        if (start < bytes_read)
+        {
+          std::memcpy(results.data() + *first * record_size, block.data() + start, std::min(record_size, bytes_read - start));
+        }
+      }
+    }
+
+    stream.clear();
+
+    return results;
+  }
+}// namespace studio::resources
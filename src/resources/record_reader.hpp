@@ -0,0 +1,32 @@
+#ifndef DARKSTARDTSCONVERTER_RECORD_READER_HPP
+#define DARKSTARDTSCONVERTER_RECORD_READER_HPP
+
+#include <vector>
+#include <istream>
+#include <cstddef>
+#include <cstring>
+#include <nonstd/span.hpp>
+
+namespace studio::resources
+{
+  // Records closer together than this are fetched with one read, along with the bytes between them.
+  constexpr std::size_t coalesced_read_size = 1024 * 1024;
+
+  // Reads record_size bytes at each of the offsets, which is how most archives store the header of every entry.
+  // Rather than seeking to each one, the offsets are visited in order and records near each other are read as one block.
+  // Streams over memory, such as span_stream, are gathered from directly without any reads at all.
+  // The records are returned back to back in the order of offsets, and any bytes past the end of the stream are zero.
+  std::vector<std::byte> read_records(std::basic_istream<std::byte>& stream, nonstd::span<const std::size_t> offsets, std::size_t record_size);
+
+  template<typename Record>
+  std::vector<Record> read_records(std::basic_istream<std::byte>& stream, nonstd::span<const std::size_t> offsets)
+  {
+    auto raw_data = read_records(stream, offsets, sizeof(Record));
+
+    std::vector<Record> results(offsets.size());
+    std::memcpy(results.data(), raw_data.data(), raw_data.size());
+    return results;
+  }
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_RECORD_READER_HPP
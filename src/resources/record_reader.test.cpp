@@ -0,0 +1,310 @@
+#include <catch2/catch.hpp>
+#include <array>
+#include <string_view>
+#include "record_reader.hpp"
+#include "mapped_file.hpp"
+#include "trophy_bass_volume.hpp"
+#include "three_space_volume.hpp"
+#include "blob_cache.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+namespace
+{
+  // An unbuffered stream buffer over memory, which counts every seek and read made through it,
+  // the same way each would be a system call on a file.
+  struct counting_buffer : std::basic_streambuf<std::byte>
+  {
+    std::vector<std::byte> bytes;
+    std::size_t position = 0;
+    int seek_count = 0;
+    int read_count = 0;
+
+    explicit counting_buffer(std::vector<std::byte> bytes) : bytes(std::move(bytes)) {}
+
+  protected:
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode) override
+    {
+      if (direction == std::ios_base::cur && offset == 0)
+      {
+        return pos_type(off_type(position));
+      }
+
+      seek_count++;
+      const auto base = direction == std::ios_base::beg ? 0 : direction == std::ios_base::cur ? off_type(position) : off_type(bytes.size());
+      position = std::size_t(std::clamp<off_type>(base + offset, 0, off_type(bytes.size())));
+      return pos_type(off_type(position));
+    }
+
+    pos_type seekpos(pos_type new_position, std::ios_base::openmode mode) override
+    {
+      return seekoff(off_type(new_position), std::ios_base::beg, mode);
+    }
+
+    std::streamsize xsgetn(std::byte* output, std::streamsize count) override
+    {
+      read_count++;
+      const auto result = std::min<std::size_t>(std::size_t(count), bytes.size() - position);
+      std::copy_n(bytes.begin() + std::ptrdiff_t(position), result, output);
+      position += result;
+      return std::streamsize(result);
+    }
+
+    int_type underflow() override
+    {
+      return position < bytes.size() ? traits_type::to_int_type(bytes[position]) : traits_type::eof();
+    }
+
+    int_type uflow() override
+    {
+      read_count++;
+      return position < bytes.size() ? traits_type::to_int_type(bytes[position++]) : traits_type::eof();
+    }
+  };
+
+  constexpr auto entry_count = 200u;
+  constexpr auto entry_data_size = 100u;
+
+  std::string get_entry_name(std::size_t index)
+  {
+    return "entry" + std::to_string(index) + ".dat";
+  }
+
+  std::vector<std::byte> create_tbv()
+  {
+    studio::resources::blob bytes;
+    studio::resources::blob_stream output(bytes);
+    write_string(output, "TBVolume", 9);
+    write_uint(output, 0, 2);
+    write_uint(output, entry_count, 2);
+    write_uint(output, 0, 4);
+    write_string(output, "RichRayl@CUC", 12);
+    write_string(output, "", 12);
+
+    auto offset = std::uint32_t(bytes.size() + entry_count * 8);
+
+    // Stored in reverse, so that the listing has to sort them.
+    for (auto i = 0u; i < entry_count; ++i)
+    {
+      write_uint(output, 0, 4);
+      write_uint(output, offset + (entry_count - 1 - i) * (28 + entry_data_size), 4);
+    }
+
+    for (auto i = 0u; i < entry_count; ++i)
+    {
+      write_string(output, get_entry_name(i), 24);
+      write_uint(output, entry_data_size + i, 4);
+      write_string(output, "", entry_data_size);
+    }
+
+    return bytes;
+  }
+
+  std::vector<std::byte> create_three_space_vol()
+  {
+    studio::resources::blob bytes;
+    studio::resources::blob_stream output(bytes);
+    write_string(output, "VOLN", 4);
+    write_string(output, "", 6);
+    write_uint(output, 6, 2);
+    write_string(output, "test\0", 6);
+    write_uint(output, entry_count, 2);
+    write_uint(output, 0, 4);
+
+    auto offset = std::uint32_t(bytes.size() + entry_count * 18);
+
+    for (auto i = 0u; i < entry_count; ++i)
+    {
+      write_string(output, get_entry_name(i), 13);
+      output.put(std::byte(0));
+      write_uint(output, offset + i * (9 + entry_data_size), 4);
+    }
+
+    for (auto i = 0u; i < entry_count; ++i)
+    {
+      output.put(std::byte(i % 2 == 0 ? 0x02 : 0x09));
+      write_uint(output, entry_data_size + i, 4);
+      write_uint(output, entry_data_size, 4);
+      write_string(output, "", entry_data_size);
+    }
+
+    return bytes;
+  }
+
+  std::vector<std::byte> create_rbx()
+  {
+    studio::resources::blob bytes;
+    studio::resources::blob_stream output(bytes);
+    output.write(std::array<std::byte, 4>{ std::byte{ 0x9e }, std::byte{ 0x9a }, std::byte{ 0xa9 }, std::byte{ 0x0b } }.data(), 4);
+    write_uint(output, entry_count, 4);
+    write_uint(output, 0, 4);
+
+    auto offset = std::uint32_t(bytes.size() + entry_count * 16);
+
+    // Stored in reverse, so that the listing has to sort them.
+    for (auto i = 0u; i < entry_count; ++i)
+    {
+      const auto index = entry_count - 1 - i;
+      write_string(output, get_entry_name(index), 12);
+      write_uint(output, offset + index * (4 + entry_data_size), 4);
+    }
+
+    for (auto i = 0u; i < entry_count; ++i)
+    {
+      write_uint(output, entry_data_size + i, 4);
+      write_string(output, "", entry_data_size);
+    }
+
+    return bytes;
+  }
+
+  // The map of an RMF only lists the offsets of each entry, whose names and sizes are in the volume file next to it.
+  std::vector<std::byte> create_rmf(const std::filesystem::path& volume_path)
+  {
+    studio::resources::blob bytes;
+    studio::resources::blob_stream output(bytes);
+    write_uint(output, 0x07050100, 4);
+    output.put(std::byte(2));
+    output.put(std::byte(0));
+
+    write_string(output, "OTHER.VOL", 13);
+    write_uint(output, 1, 2);
+    write_uint(output, 0, 4);
+    write_uint(output, 0, 4);
+
+    write_string(output, volume_path.filename().string(), 13);
+    write_uint(output, entry_count, 2);
+
+    for (auto i = 0u; i < entry_count; ++i)
+    {
+      const auto index = entry_count - 1 - i;
+      write_uint(output, 0x1000 + index, 4);
+      write_uint(output, index * (17 + entry_data_size), 4);
+    }
+
+    std::basic_ofstream<std::byte> volume(volume_path, std::ios::binary | std::ios::trunc);
+
+    for (auto i = 0u; i < entry_count; ++i)
+    {
+      write_string(volume, get_entry_name(i), 13);
+      write_uint(volume, entry_data_size + i, 4);
+      write_string(volume, "", entry_data_size);
+    }
+
+    return bytes;
+  }
+}
+
+TEST_CASE("Records are gathered in the order of their offsets", "[resources.record_reader]")
+{
+  std::vector<std::byte> bytes;
+
+  for (auto i = 0; i < 64; ++i)
+  {
+    bytes.emplace_back(std::byte(i));
+  }
+
+  const std::vector<std::size_t> offsets = { 40, 2, 62, 10 };
+
+  counting_buffer buffer(bytes);
+  std::basic_istream<std::byte> stream(&buffer);
+
+  auto records = studio::resources::read_records(stream, offsets, 4);
+
+  REQUIRE(records.size() == 16);
+  REQUIRE(records[0] == std::byte{ 40 });
+  REQUIRE(records[4] == std::byte{ 2 });
+  REQUIRE(records[8] == std::byte{ 62 });
+  REQUIRE(records[9] == std::byte{ 63 });
+  REQUIRE(records[10] == std::byte{ 0 });
+  REQUIRE(records[12] == std::byte{ 10 });
+  REQUIRE(buffer.read_count == 1);
+
+  studio::resources::span_stream memory(bytes);
+  REQUIRE(studio::resources::read_records(memory, offsets, 4) == records);
+}
+
+TEST_CASE("Listing a TBV reads its table of contents in a constant number of calls", "[resources.record_reader]")
+{
+  counting_buffer buffer(create_tbv());
+  std::basic_istream<std::byte> stream(&buffer);
+
+  studio::resources::vol::trophy_bass::tbv_file_archive archive;
+  auto listing = archive.get_content_listing(stream, "test.tbv");
+
+  REQUIRE(listing.size() == entry_count);
+  REQUIRE(buffer.seek_count <= 2);
+  REQUIRE(buffer.read_count <= 4);
+
+  for (auto i = 0u; i < entry_count; ++i)
+  {
+    auto& info = std::get<studio::resources::file_info>(listing[i]);
+    REQUIRE(info.filename == get_entry_name(i));
+    REQUIRE(info.size == entry_data_size + i);
+  }
+}
+
+TEST_CASE("Listing a 3Space VOL reads its table of contents in a constant number of calls", "[resources.record_reader]")
+{
+  counting_buffer buffer(create_three_space_vol());
+  std::basic_istream<std::byte> stream(&buffer);
+
+  studio::resources::vol::three_space::vol_file_archive archive;
+  auto listing = archive.get_content_listing(stream, "test");
+
+  REQUIRE(listing.size() == entry_count);
+  REQUIRE(buffer.seek_count <= 2);
+  REQUIRE(buffer.read_count <= 8);
+
+  for (auto i = 0u; i < entry_count; ++i)
+  {
+    auto& info = std::get<studio::resources::file_info>(listing[i]);
+    REQUIRE(info.filename == get_entry_name(i));
+    REQUIRE(info.size == entry_data_size + i);
+    REQUIRE(info.compression_type == (i % 2 == 0 ? studio::resources::compression_type::none : studio::resources::compression_type::lz));
+  }
+}
+
+TEST_CASE("Listing an RBX reads its table of contents in a constant number of calls", "[resources.record_reader]")
+{
+  counting_buffer buffer(create_rbx());
+  std::basic_istream<std::byte> stream(&buffer);
+
+  studio::resources::vol::trophy_bass::rbx_file_archive archive;
+  auto listing = archive.get_content_listing(stream, "test.rbx");
+
+  REQUIRE(listing.size() == entry_count);
+  REQUIRE(buffer.seek_count <= 2);
+  REQUIRE(buffer.read_count <= 6);
+
+  for (auto i = 0u; i < entry_count; ++i)
+  {
+    auto& info = std::get<studio::resources::file_info>(listing[i]);
+    REQUIRE(info.filename == get_entry_name(i));
+    REQUIRE(info.size == entry_data_size + i);
+  }
+}
+
+TEST_CASE("Listing a volume of an RMF reads its map in a constant number of calls", "[resources.record_reader]")
+{
+  temp_folder folder("3space-rmf-test");
+  counting_buffer buffer(create_rmf(folder.path / "TEST.VOL"));
+  std::basic_istream<std::byte> stream(&buffer);
+
+  studio::resources::vol::three_space::rmf_file_archive archive;
+  auto listing = archive.get_content_listing(stream, folder.path / "test.rmf" / "TEST.VOL");
+
+  REQUIRE(listing.size() == entry_count);
+  REQUIRE(buffer.seek_count <= 1);
+  REQUIRE(buffer.read_count <= 6);
+
+  for (auto i = 0u; i < entry_count; ++i)
+  {
+    auto& info = std::get<studio::resources::file_info>(listing[i]);
+    REQUIRE(info.filename == get_entry_name(i));
+    REQUIRE(info.size == entry_data_size + i);
+    REQUIRE(info.offset == i * (17 + entry_data_size));
+    REQUIRE(info.checksum == 0x1000 + i);
+  }
+}
@@ -1,6 +1,11 @@
 #include <sstream>
+#include <execution>
+#include <unordered_set>
 #include "resource_explorer.hpp"
 #include "shared.hpp"
+#include "block_copy.hpp"
+#include "range_stream.hpp"
+#include "compression.hpp"
 
 namespace studio::resources
 {
@@ -8,7 +13,8 @@ namespace studio::resources
   {
     auto archive_path = folder_path;
 
-    while (!std::filesystem::exists(archive_path) && !std::filesystem::is_directory(archive_path))
+    // A relative path runs out of parents without reaching one which exists, so the walk ends there too.
+    while (!std::filesystem::exists(archive_path) && !std::filesystem::is_directory(archive_path) && archive_path.has_parent_path())
     {
       archive_path = archive_path.parent_path();
     }
@@ -36,6 +42,19 @@ namespace studio::resources
     return search_path;
   }
 
+  void resource_explorer::load_index(const std::filesystem::path& index_path)
+  {
+    index = std::make_unique<workspace_index>(index_path);
+  }
+
+  void resource_explorer::save_index() const
+  {
+    if (index)
+    {
+      index->save();
+    }
+  }
+
   void resource_explorer::add_archive_type(std::string extension, std::unique_ptr<studio::resources::archive_plugin> archive_type, std::optional<nonstd::span<std::string_view>> explicit_extensions)
   {
     auto result = archive_types.insert(std::make_pair(shared::to_lower(extension), std::move(archive_type)));
@@ -52,16 +71,114 @@ namespace studio::resources
     key << new_search_path;
     std::for_each(extensions.begin(), extensions.end(), [&](auto& ext) { key << ext; });
 
-    auto cache_result = info_cache.find(key.str());
+    if (auto cache_result = info_cache->find(key.str()); cache_result.has_value())
+    {
+      return std::move(cache_result.value());
+    }
+
+    // There are specific archives that must not be queried, unless
+    // they or their supported formats are explicitly queried.
+    auto must_be_skipped = [&](const std::filesystem::path& archive_path) {
+      const auto ext = shared::to_lower(archive_path.extension().string());
+      auto must_be_explicit = archive_explicit_extensions.find(ext);
+
+      if (must_be_explicit == archive_explicit_extensions.end())
+      {
+        return false;
+      }
+
+      auto count = std::count(extensions.begin(), extensions.end(), "ALL");
+
+      if (count == 0)
+      {
+        count = std::count(extensions.begin(), extensions.end(), ext);
+      }
+
+      if (count == 0)
+      {
+        for (auto value : must_be_explicit->second)
+        {
+          count += std::count(extensions.begin(), extensions.end(), value);
+        }
+      }
+
+      return count == 0;
+    };
 
-    if (cache_result != info_cache.end())
+    struct folder_listing
     {
-      return cache_result->second;
+      bool is_archive_file = false;
+      std::vector<std::variant<studio::resources::folder_info, studio::resources::file_info>> items;
+      std::exception_ptr error;
+    };
+
+    auto files_folders = get_content_listing(new_search_path);
+
+    // Every folder and archive is listed up front, one level of the tree at a time,
+    // so that the slow part (directory reads and archive parsing) can run in parallel.
+    std::map<std::filesystem::path, folder_listing> listings;
+    std::vector<std::filesystem::path> pending;
+
+    auto queue_folders = [&](const auto& items) {
+      for (auto& item : items)
+      {
+        if (auto* folder = std::get_if<studio::resources::folder_info>(&item); folder != nullptr)
+        {
+          pending.emplace_back(folder->full_path);
+        }
+      }
+    };
+
+    queue_folders(files_folders);
+
+    while (!pending.empty())
+    {
+      std::vector<std::optional<folder_listing>> level(pending.size());
+
+      std::transform(std::execution::par, pending.begin(), pending.end(), level.begin(), [&](const auto& folder_path) -> std::optional<folder_listing> {
+        folder_listing result{};
+
+        try
+        {
+          result.is_archive_file = std::filesystem::exists(folder_path) ? !std::filesystem::is_directory(folder_path) : entries->find(folder_path).has_value();
+
+          if (result.is_archive_file && must_be_skipped(folder_path))
+          {
+            return std::nullopt;
+          }
+
+          result.items = get_content_listing(folder_path);
+        }
+        catch (...)
+        {
+          result.error = std::current_exception();
+        }
+
+        return result;
+      });
+
+      auto current = std::move(pending);
+      pending.clear();
+
+      for (auto i = 0u; i < current.size(); ++i)
+      {
+        if (level[i].has_value())
+        {
+          if (auto [listing, is_new] = listings.emplace(std::move(current[i]), std::move(level[i].value())); is_new)
+          {
+            queue_folders(listing->second.items);
+          }
+        }
+      }
     }
 
+    // The results are then gathered in the same depth-first order as the listings.
     std::vector<studio::resources::file_info> results;
 
-    auto files_folders = get_content_listing(new_search_path);
+    auto matches_extension = [&](const std::filesystem::path& filename) {
+      auto ext = shared::to_lower(filename.extension().string());
+      return std::find(extensions.begin(), extensions.end(), ext) != extensions.end();
+    };
 
     std::function<void(decltype(files_folders)::const_reference)> get_files_folders = [&](const auto& file_folder) {
       std::visit([&](const auto& folder) {
@@ -69,55 +186,34 @@ namespace studio::resources
 
         if constexpr (std::is_same_v<T, studio::resources::folder_info>)
         {
-          const auto& real_folder = static_cast<const studio::resources::folder_info&>(folder);
-
-          const auto ext = shared::to_lower(real_folder.full_path.extension().string());
+          auto listing = listings.find(folder.full_path);
 
-          // There are specific archives that must not be queried, unless
-          // they or their supported formats are explicitly queried.
-          if (auto must_be_explicit = archive_explicit_extensions.find(ext);
-              std::filesystem::exists(folder.full_path) &&
-              !std::filesystem::is_directory(real_folder.full_path) && must_be_explicit != archive_explicit_extensions.end())
+          if (listing == listings.end())
           {
-            auto count = std::count(extensions.begin(), extensions.end(), "ALL");
-
-            if (count == 0)
-            {
-              count = std::count(extensions.begin(), extensions.end(), ext);
-            }
-
-            if (count == 0)
-            {
-              for (auto value : must_be_explicit->second)
-              {
-                count += std::count(extensions.begin(), extensions.end(), value);
-              }
-
-              if (count == 0)
-              {
-                return;
-              }
-            }
+            return;
           }
 
-          auto more_files = get_content_listing(folder.full_path);
+          if (listing->second.error)
+          {
+            std::rethrow_exception(listing->second.error);
+          }
 
-          if (std::filesystem::exists(folder.full_path) && !std::filesystem::is_directory(folder.full_path))
+          if (listing->second.is_archive_file && matches_extension(folder.full_path.filename()))
           {
-            for (auto& extension : extensions)
+            if (auto entry = entries->find(folder.full_path); entry.has_value())
+            {
+              results.emplace_back(std::move(entry.value()));
+            }
+            else
             {
-              if (shared::to_lower(folder.full_path.filename().extension().string()) == extension)
-              {
-                studio::resources::file_info info{};
-                info.filename = folder.full_path.filename();
-                info.folder_path = folder.full_path.parent_path();
-                results.emplace_back(info);
-                break;
-              }
+              studio::resources::file_info info{};
+              info.filename = folder.full_path.filename();
+              info.folder_path = folder.full_path.parent_path();
+              results.emplace_back(info);
             }
           }
 
-          for (auto& item : more_files)
+          for (auto& item : listing->second.items)
           {
             get_files_folders(item);
           }
@@ -125,22 +221,10 @@ namespace studio::resources
 
         if constexpr (std::is_same_v<T, studio::resources::file_info>)
         {
-          if (extensions.size() == 1 && extensions.front() == "ALL")
+          if ((extensions.size() == 1 && extensions.front() == "ALL") || matches_extension(folder.filename))
           {
             results.emplace_back(folder);
           }
-          else
-          {
-            for (auto& extension : extensions)
-            {
-              auto ext = shared::to_lower(folder.filename.extension().string());
-              if (ext == extension)
-              {
-                results.emplace_back(folder);
-                break;
-              }
-            }
-          }
         }
       },
         file_folder);
@@ -151,7 +235,7 @@ namespace studio::resources
       get_files_folders(item);
     }
 
-    info_cache.emplace(key.str(), results);
+    info_cache->insert(key.str(), results);
 
     return results;
   }
@@ -161,18 +245,42 @@ namespace studio::resources
     return find_files(search_path, extensions);
   }
 
+  std::shared_ptr<const studio::resources::overlay_index> resource_explorer::get_overlay_index(const std::vector<std::string_view>& extensions) const
+  {
+    std::stringstream key;
+    std::for_each(extensions.begin(), extensions.end(), [&](auto& ext) { key << shared::to_lower(std::string(ext)) << ';'; });
+
+    {
+      std::lock_guard<std::mutex> lock(overlay_indexes->mutex);
+
+      if (auto existing = overlay_indexes->indexes.find(key.str()); existing != overlay_indexes->indexes.end())
+      {
+        return existing->second;
+      }
+    }
+
+    auto result = std::make_shared<const overlay_index>(overlay_index::build(find_files(extensions)));
+
+    std::lock_guard<std::mutex> lock(overlay_indexes->mutex);
+    return overlay_indexes->indexes.emplace(key.str(), std::move(result)).first->second;
+  }
+
   void resource_explorer::merge_results(std::vector<studio::resources::file_info>& group1,
     const std::vector<studio::resources::file_info>& group2)
   {
     group1.reserve(group1.capacity() + group2.size());
 
-    for (auto& group2_item : group2)
+    auto hash_path = [](const std::filesystem::path& path) { return std::filesystem::hash_value(path); };
+    std::unordered_set<std::filesystem::path, decltype(hash_path)> folders(group1.size() + group2.size(), hash_path);
+
+    for (auto& group1_item : group1)
     {
-      auto result = std::find_if(group1.begin(), group1.end(), [&](const auto& group1_item) {
-        return group1_item.folder_path == group2_item.folder_path;
-      });
+      folders.emplace(group1_item.folder_path);
+    }
 
-      if (result == group1.end())
+    for (auto& group2_item : group2)
+    {
+      if (folders.count(group2_item.folder_path) == 0)
       {
         group1.emplace_back(group2_item);
       }
@@ -190,43 +298,412 @@ namespace studio::resources
   }
 
   file_stream resource_explorer::load_file(const studio::resources::file_info& info) const
+  {
+    if (trace)
+    {
+      trace->record(info);
+    }
+
+    return open_file(info);
+  }
+
+  file_stream resource_explorer::stream_file(const studio::resources::file_info& info) const
+  {
+    if (trace)
+    {
+      trace->record(info);
+    }
+
+    return open_stream(info);
+  }
+
+  void resource_explorer::set_access_trace(std::shared_ptr<access_trace> new_trace)
+  {
+    trace = std::move(new_trace);
+  }
+
+  file_stream resource_explorer::open_file(const studio::resources::file_info& info) const
   {
     if (info.compression_type == studio::resources::compression_type::none)
     {
-      if (std::filesystem::is_directory(info.folder_path))
+      if (auto archive = get_mapped_archive(info); archive.has_value())
+      {
+        auto view = get_file_view(info);
+        return std::make_pair(info, std::make_unique<span_stream>(view.value(), archive->file));
+      }
+      else if (std::filesystem::is_directory(info.folder_path))
       {
         return std::make_pair(info, std::make_unique<std::basic_ifstream<std::byte>>(info.folder_path / info.filename, std::ios::binary));
       }
+      else if (auto archive = open_archive(info.folder_path); archive.has_value())
+      {
+        auto& [plugin, stream] = archive.value();
+        plugin.get().set_stream_position(*stream, info);
+        const auto position = std::uint64_t(std::max<std::streamoff>(stream->tellg(), 0));
+
+        return std::make_pair(info, std::make_unique<range_stream>(std::move(stream), position, info.size));
+      }
       else
       {
-        auto archive_path = get_archive_path(info.folder_path);
-        auto file_stream = std::make_unique<std::basic_ifstream<std::byte>>(archive_path, std::ios::binary);
+        return std::make_pair(info, std::make_unique<std::basic_ifstream<std::byte>>(get_archive_path(info.folder_path), std::ios::binary));
+      }
+    }
+    else
+    {
+      auto key = get_blob_key(info);
+
+      if (key.has_value())
+      {
+        if (auto existing = blobs->find(key.value()); existing)
+        {
+          return std::make_pair(info, std::make_unique<span_stream>(nonstd::span<const std::byte>(existing->data(), existing->size()), existing));
+        }
+      }
+
+      auto archive = open_archive(info.folder_path);
+
+      auto memory_stream = std::make_unique<std::basic_stringstream<std::byte>>();
+
+      if (!archive.has_value())
+      {
+        return std::make_pair(info, std::move(memory_stream));
+      }
+
+      archive->first.get().extract_file_contents(*archive->second, info, *memory_stream);
+
+      auto contents = memory_stream->str();
+      auto result = std::make_shared<const blob>(contents.begin(), contents.end());
+
+      if (key.has_value())
+      {
+        blobs->insert(key.value(), result);
+      }
+
+      return std::make_pair(info, std::make_unique<span_stream>(nonstd::span<const std::byte>(result->data(), result->size()), result));
+    }
+  }
+
+  file_stream resource_explorer::open_stream(const studio::resources::file_info& info) const
+  {
+    if (info.compression_type == studio::resources::compression_type::none)
+    {
+      return open_file(info);
+    }
+
+    auto key = get_blob_key(info);
+
+    if (!key.has_value())
+    {
+      return open_file(info);
+    }
+
+    if (auto existing = blobs->find(key.value()); existing)
+    {
+      return std::make_pair(info, std::make_unique<span_stream>(nonstd::span<const std::byte>(existing->data(), existing->size()), existing));
+    }
+
+    auto archive = open_archive(info.folder_path);
+
+    if (!archive.has_value())
+    {
+      return open_file(info);
+    }
+
+    std::shared_ptr<decompression_index> index;
+
+    {
+      std::lock_guard<std::mutex> lock(decompression_indexes->mutex);
+      auto& existing = decompression_indexes->indexes[key.value()];
+
+      if (!existing)
+      {
+        existing = std::make_shared<decompression_index>();
+      }
+
+      index = existing;
+    }
+
+    if (auto stream = archive->first.get().open_compressed_entry(std::move(archive->second), info, std::move(index)); stream)
+    {
+      return std::make_pair(info, std::move(stream));
+    }
+
+    return open_file(info);
+  }
+
+  std::optional<std::string> resource_explorer::get_blob_key(const studio::resources::file_info& info) const
+  {
+    auto archive_path = get_archive_path(info.folder_path);
+    auto stamp = get_file_stamp(archive_path);
+
+    if (!stamp.has_value())
+    {
+      return std::nullopt;
+    }
+
+    std::stringstream key;
+    key << archive_path << '|' << stamp->size << '|' << stamp->last_write_time << '|' << normalise_path(info.folder_path / info.filename) << '|' << info.offset;
+    return key.str();
+  }
+
+  std::shared_ptr<blob_cache> resource_explorer::get_blob_cache() const
+  {
+    return blobs;
+  }
+
+  void resource_explorer::set_blob_cache(std::shared_ptr<blob_cache> cache)
+  {
+    blobs = std::move(cache);
+  }
+
+  std::optional<mapped_archive> resource_explorer::get_mapped_archive(const studio::resources::file_info& info) const
+  {
+    {
+      std::shared_lock<std::shared_mutex> lock(mapped_archives->mutex);
+
+      if (auto existing = mapped_archives->folders.find(info.folder_path); existing != mapped_archives->folders.end())
+      {
+        return existing->second;
+      }
+    }
+
+    // An archive inside another one is a view into the mapping of the outer archive, as long as it is stored uncompressed.
+    if (auto nested = find_nested_archive(info.folder_path); nested.has_value())
+    {
+      std::optional<mapped_archive> result;
+
+      if (auto parent = get_mapped_archive(nested->info); parent.has_value())
+      {
+        if (auto view = get_file_view(nested->info); view.has_value())
+        {
+          result.emplace(mapped_archive{ parent->file, nested->plugin, view.value(), parent->data_path });
+        }
+      }
+
+      std::unique_lock<std::shared_mutex> lock(mapped_archives->mutex);
+      return mapped_archives->folders.emplace(info.folder_path, std::move(result)).first->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mapped_archives->mutex);
+
+    if (auto existing = mapped_archives->folders.find(info.folder_path); existing != mapped_archives->folders.end())
+    {
+      return existing->second;
+    }
+
+    auto& result = mapped_archives->folders[info.folder_path];
+
+    if (std::filesystem::is_directory(info.folder_path))
+    {
+      return result;
+    }
+
+    auto archive_path = get_archive_path(info.folder_path);
+    auto archive = get_archive_type(archive_path);
+
+    if (!archive.has_value())
+    {
+      return result;
+    }
+
+    auto data_path = archive->get().get_data_path(archive_path, info);
+    auto& file = mapped_archives->files[data_path];
+
+    if (!file)
+    {
+      try
+      {
+        file = std::make_shared<mapped_file>(data_path);
+      }
+      catch (const std::system_error&)
+      {
+        return result;
+      }
+    }
+
+    result.emplace(mapped_archive{ file, archive.value(), file->data(), data_path });
 
-        auto archive = get_archive_type(archive_path);
+    return result;
+  }
+
+  std::optional<nonstd::span<const std::byte>> resource_explorer::get_file_view(const studio::resources::file_info& info) const
+  {
+    if (info.compression_type != studio::resources::compression_type::none)
+    {
+      return std::nullopt;
+    }
+
+    auto archive = get_mapped_archive(info);
+
+    if (!archive.has_value())
+    {
+      return std::nullopt;
+    }
+
+    auto data = archive->data;
+    span_stream stream(data);
+    archive->plugin.get().set_stream_position(stream, info);
+
+    auto position = stream.tellg();
+
+    if (!stream || position < 0 || std::size_t(position) > data.size())
+    {
+      return nonstd::span<const std::byte>{};
+    }
+
+    return data.subspan(std::size_t(position), std::min(info.size, data.size() - std::size_t(position)));
+  }
+
+  std::size_t resource_explorer::read_entry(const studio::resources::file_info& info, std::uint64_t offset, nonstd::span<std::byte> output) const
+  {
+    if (auto view = get_file_view(info); view.has_value())
+    {
+      if (offset >= view->size())
+      {
+        return 0;
+      }
+
+      const auto count = std::min<std::size_t>(output.size(), view->size() - std::size_t(offset));
+      std::copy_n(view->data() + offset, count, output.data());
+      return count;
+    }
+
+    auto read_from_stream = [&](std::basic_istream<std::byte>& stream) {
+      stream.seekg(std::streamoff(offset), std::ios::beg);
+      stream.read(output.data(), std::streamsize(output.size()));
+      return std::size_t(std::max<std::streamsize>(stream.gcount(), 0));
+    };
 
-        if (archive.has_value())
+    // Compressed entries go through the blob cache, and each load has a stream of its own.
+    if (info.compression_type != studio::resources::compression_type::none || find_nested_archive(info.folder_path).has_value())
+    {
+      return read_from_stream(*open_file(info).second);
+    }
+
+    if (std::filesystem::is_directory(info.folder_path))
+    {
+      auto source = get_positional_file(info.folder_path / info.filename);
+      return source ? source->read(offset, output) : 0;
+    }
+
+    auto archive_path = get_archive_path(info.folder_path);
+    auto archive = get_archive_type(archive_path);
+
+    if (!archive.has_value())
+    {
+      return 0;
+    }
+
+    auto source = get_positional_file(archive->get().get_data_path(archive_path, info));
+    return source ? archive->get().read_entry(*source, info, offset, output) : 0;
+  }
+
+  std::shared_ptr<studio::resources::positional_file> resource_explorer::get_positional_file(const std::filesystem::path& path) const
+  {
+    {
+      std::shared_lock<std::shared_mutex> lock(mapped_archives->mutex);
+
+      if (auto existing = mapped_archives->sources.find(path); existing != mapped_archives->sources.end())
+      {
+        return existing->second;
+      }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mapped_archives->mutex);
+    auto& result = mapped_archives->sources[path];
+
+    if (!result)
+    {
+      try
+      {
+        result = std::make_shared<studio::resources::positional_file>(path);
+      }
+      catch (const std::system_error&)
+      {
+        mapped_archives->sources.erase(path);
+        return nullptr;
+      }
+    }
+
+    return result;
+  }
+
+  std::optional<nested_archive> resource_explorer::find_nested_archive(const std::filesystem::path& folder_path) const
+  {
+    for (auto candidate = folder_path; !candidate.empty() && !std::filesystem::exists(candidate); candidate = candidate.parent_path())
+    {
+      if (archive_types.find(shared::to_lower(candidate.extension().string())) == archive_types.end())
+      {
+        continue;
+      }
+
+      auto entry = entries->find(candidate);
+
+      if (!entry.has_value())
+      {
+        // The archive holding it may not have been listed yet.
+        try
+        {
+          get_content_listing(candidate.parent_path());
+          entry = entries->find(candidate);
+        }
+        catch (const std::exception&)
         {
-          archive->get().set_stream_position(*file_stream, info);
+          continue;
         }
+      }
+
+      if (!entry.has_value())
+      {
+        continue;
+      }
 
-        return std::make_pair(info, std::move(file_stream));
+      if (auto plugin = get_archive_type(entry.value()); plugin.has_value())
+      {
+        return nested_archive{ std::move(entry.value()), plugin.value() };
       }
     }
-    else
+
+    return std::nullopt;
+  }
+
+  std::optional<std::pair<std::reference_wrapper<studio::resources::archive_plugin>, std::unique_ptr<std::basic_istream<std::byte>>>> resource_explorer::open_archive(const std::filesystem::path& folder_path) const
+  {
+    if (auto nested = find_nested_archive(folder_path); nested.has_value())
     {
-      auto archive_path = get_archive_path(info.folder_path);
+      return std::make_pair(nested->plugin, open_file(nested->info).second);
+    }
 
-      auto file_stream = std::basic_ifstream<std::byte>(archive_path, std::ios::binary);
-      auto archive = get_archive_type(archive_path);
+    auto archive_path = get_archive_path(folder_path);
 
-      auto memory_stream = std::make_unique<std::basic_stringstream<std::byte>>();
+    if (auto archive = get_archive_type(archive_path); archive.has_value())
+    {
+      return std::make_pair(archive.value(), std::unique_ptr<std::basic_istream<std::byte>>(std::make_unique<std::basic_ifstream<std::byte>>(archive_path, std::ios::binary)));
+    }
 
-      if (archive.has_value())
+    return std::nullopt;
+  }
+
+  void resource_explorer::add_nested_archives(std::vector<std::variant<studio::resources::folder_info, studio::resources::file_info>>& listing) const
+  {
+    const auto size = listing.size();
+
+    for (auto i = 0u; i < size; ++i)
+    {
+      auto* file = std::get_if<studio::resources::file_info>(&listing[i]);
+
+      if (file == nullptr || archive_types.find(shared::to_lower(file->filename.extension().string())) == archive_types.end())
       {
-        archive->get().extract_file_contents(file_stream, info, *memory_stream);
+        continue;
       }
 
-      return std::make_pair(info, std::move(memory_stream));
+      if (get_archive_type(*file).has_value())
+      {
+        studio::resources::folder_info folder{};
+        folder.name = file->filename.string();
+        folder.full_path = file->folder_path / file->filename;
+        listing.emplace_back(std::move(folder));
+      }
     }
   }
 
@@ -239,6 +716,11 @@ namespace studio::resources
       return !(std::filesystem::is_directory(folder_path) || get_archive_type(folder_path).has_value());
     }
 
+    if (auto nested = find_nested_archive(folder_path); nested.has_value() && nested->info.folder_path / nested->info.filename == folder_path)
+    {
+      return false;
+    }
+
     return folder_path.has_extension();
   }
 
@@ -247,51 +729,191 @@ namespace studio::resources
     auto ext = shared::to_lower(file_path.filename().extension().string());
     auto archive_type = archive_types.equal_range(ext);
 
+    if (archive_type.first == archive_type.second)
+    {
+      return std::nullopt;
+    }
+
+    auto to_result = [](studio::resources::archive_plugin* plugin) -> std::optional<std::reference_wrapper<studio::resources::archive_plugin>> {
+      if (plugin == nullptr)
+      {
+        return std::nullopt;
+      }
+
+      return std::ref(*plugin);
+    };
+
+    if (auto existing = archive_formats->find(file_path, file_path); existing.has_value())
+    {
+      return to_result(existing.value());
+    }
+
+    // The header is read once and every candidate plugin checks it from memory.
+    const header_prefix header(file_path);
+    studio::resources::archive_plugin* result = nullptr;
+
     for (auto it = archive_type.first; it != archive_type.second; ++it)
     {
-      auto file_stream = std::basic_ifstream<std::byte>{ file_path, std::ios::binary };
+      if (header.matches([&](auto& stream) { return it->second->stream_is_supported(stream); }))
+      {
+        result = it->second.get();
+        break;
+      }
+    }
+
+    archive_formats->insert(file_path, file_path, result);
+
+    return to_result(result);
+  }
+
+  std::optional<std::reference_wrapper<studio::resources::archive_plugin>> resource_explorer::get_archive_type(const studio::resources::file_info& entry) const
+  {
+    auto archive_type = archive_types.equal_range(shared::to_lower(entry.filename.extension().string()));
+
+    if (archive_type.first == archive_type.second)
+    {
+      return std::nullopt;
+    }
 
-      if (it->second->stream_is_supported(file_stream))
+    auto to_result = [](studio::resources::archive_plugin* plugin) -> std::optional<std::reference_wrapper<studio::resources::archive_plugin>> {
+      if (plugin == nullptr)
       {
-        return std::ref(*it->second);
+        return std::nullopt;
       }
+
+      return std::ref(*plugin);
+    };
+
+    const auto entry_path = entry.folder_path / entry.filename;
+    const auto source_path = get_archive_path(entry.folder_path);
+
+    if (auto existing = archive_formats->find(entry_path, source_path); existing.has_value())
+    {
+      return to_result(existing.value());
     }
 
-    return std::nullopt;
+    auto [loaded_info, stream] = open_stream(entry);
+    const header_prefix header(*stream);
+    studio::resources::archive_plugin* result = nullptr;
+
+    for (auto it = archive_type.first; it != archive_type.second; ++it)
+    {
+      if (header.matches([&](auto& prefix) { return it->second->stream_is_supported(prefix); }))
+      {
+        result = it->second.get();
+        break;
+      }
+    }
+
+    archive_formats->insert(entry_path, source_path, result);
+
+    return to_result(result);
   }
 
-  void resource_explorer::extract_file_contents(std::basic_istream<std::byte>& archive_file, std::filesystem::path destination, const studio::resources::file_info& info) const
+  std::filesystem::path resource_explorer::get_extraction_folder(const std::filesystem::path& destination, const studio::resources::file_info& info) const
   {
     auto archive_path = get_archive_path(info.folder_path);
 
-    destination = destination / std::filesystem::relative(archive_path, search_path).parent_path() / archive_path.stem() / std::filesystem::relative(info.folder_path, archive_path).replace_extension("");
+    auto result = destination / std::filesystem::relative(archive_path, search_path).parent_path() / archive_path.stem() / std::filesystem::relative(info.folder_path, archive_path).replace_extension("");
 
-    if (archive_path.stem() == destination.stem())
+    if (archive_path.stem() == result.stem())
     {
-      destination = destination.parent_path();
+      result = result.parent_path();
     }
 
+    return result;
+  }
+
+  void resource_explorer::extract_file_contents(std::basic_istream<std::byte>& archive_file, std::filesystem::path destination, const studio::resources::file_info& info) const
+  {
+    auto archive_path = get_archive_path(info.folder_path);
+
+    destination = get_extraction_folder(destination, info);
+
     std::filesystem::create_directories(destination);
 
+    const auto view = get_file_view(info);
+
+    if (view.has_value() && !view->empty())
+    {
+      // Uncompressed entries are copied straight from the archive file, without passing through this process where possible.
+      auto archive = get_mapped_archive(info);
+      const auto offset = std::uint64_t(view->data() - archive->file->data().data());
+
+      if (copy_file_region(archive->data_path, offset, view->size(), destination / info.filename))
+      {
+        return;
+      }
+    }
+
     std::basic_ofstream<std::byte> new_file(destination / info.filename, std::ios::binary);
 
-    auto type = get_archive_type(archive_path);
+    if (view.has_value())
+    {
+      new_file.write(view->data(), std::streamsize(view->size()));
+      return;
+    }
+
+    extract_file_contents(archive_file, info, new_file);
+  }
+
+  void resource_explorer::extract_file_contents(std::basic_istream<std::byte>& archive_file, const studio::resources::file_info& info, std::basic_ostream<std::byte>& output) const
+  {
+    // Entries of nested archives are read from the entry holding them, not from the outer archive file.
+    if (auto nested = find_nested_archive(info.folder_path); nested.has_value())
+    {
+      auto [nested_info, nested_stream] = open_file(nested->info);
+      nested->plugin.get().extract_file_contents(*nested_stream, info, output);
+      return;
+    }
+
+    auto type = get_archive_type(get_archive_path(info.folder_path));
 
     if (type.has_value())
     {
-      type->get().extract_file_contents(archive_file, info, new_file);
+      type->get().extract_file_contents(archive_file, info, output);
     }
   }
 
   std::vector<std::variant<studio::resources::folder_info, studio::resources::file_info>> resource_explorer::get_content_listing(const std::filesystem::path& folder_path) const
+  {
+    auto results = list_contents(folder_path);
+    entries->insert(folder_path, results);
+    return results;
+  }
+
+  std::optional<studio::resources::file_info> resource_explorer::find_file(const std::filesystem::path& file_path) const
+  {
+    return entries->find(file_path);
+  }
+
+  std::vector<std::variant<studio::resources::folder_info, studio::resources::file_info>> resource_explorer::list_contents(const std::filesystem::path& folder_path) const
   {
     std::vector<std::variant<studio::resources::folder_info, studio::resources::file_info>> files;
 
-    if (auto archive_type = get_archive_type(get_archive_path(folder_path)); archive_type.has_value())
+    const auto archive_path = get_archive_path(folder_path);
+
+    if (index)
+    {
+      if (auto existing = index->find(archive_path, folder_path); existing.has_value())
+      {
+        return std::move(existing.value());
+      }
+    }
+
+    if (auto archive = open_archive(folder_path); archive.has_value())
     {
-      auto file_stream = std::basic_ifstream<std::byte>{ get_archive_path(folder_path), std::ios::binary };
+      auto& [archive_type, file_stream] = archive.value();
+
+      auto results = archive_type.get().get_content_listing(*file_stream, folder_path);
+      add_nested_archives(results);
+
+      if (index)
+      {
+        index->insert(archive_path, folder_path, results);
+      }
 
-      return archive_type.value().get().get_content_listing(file_stream, folder_path);
+      return results;
     }
 
     for (auto& item : std::filesystem::directory_iterator(folder_path))
@@ -303,7 +925,7 @@ namespace studio::resources
         info.full_path = item.path();
         files.emplace_back(info);
       }
-      else if (auto archive_type = get_archive_type(item.path()); archive_type.has_value())
+      else if ((index && index->contains(item.path())) || get_archive_type(item.path()).has_value())
       {
         studio::resources::folder_info info{};
         info.name = item.path().filename().string();
@@ -9,8 +9,19 @@
 #include <fstream>
 #include <optional>
 #include <functional>
+#include <mutex>
+#include <shared_mutex>
 #include <nonstd/span.hpp>
 #include "archive_plugin.hpp"
+#include "mapped_file.hpp"
+#include "workspace_index.hpp"
+#include "format_sniffer.hpp"
+#include "entry_table.hpp"
+#include "entry_index.hpp"
+#include "listing_cache.hpp"
+#include "blob_cache.hpp"
+#include "overlay_index.hpp"
+#include "access_trace.hpp"
 
 namespace studio::resources
 {
@@ -21,6 +32,44 @@ namespace studio::resources
     int overflow(int c) { return c; }
   };
 
+  struct mapped_archive
+  {
+    std::shared_ptr<studio::resources::mapped_file> file;
+    std::reference_wrapper<studio::resources::archive_plugin> plugin;
+    // The bytes of the archive itself, which for an archive stored inside another one is only part of the file.
+    nonstd::span<const std::byte> data;
+    std::filesystem::path data_path;
+  };
+
+  // An archive which is an entry of another archive.
+  struct nested_archive
+  {
+    studio::resources::file_info info;
+    std::reference_wrapper<studio::resources::archive_plugin> plugin;
+  };
+
+  struct mapped_archive_cache
+  {
+    std::shared_mutex mutex;
+    std::map<std::filesystem::path, std::shared_ptr<studio::resources::mapped_file>> files;
+    std::map<std::filesystem::path, std::optional<mapped_archive>> folders;
+    // Files which could not be mapped are read with positional reads instead, over one handle per file.
+    std::map<std::filesystem::path, std::shared_ptr<studio::resources::positional_file>> sources;
+  };
+
+  // Checkpoints of the compressed entries which have been streamed, under the same keys as the blob cache.
+  struct decompression_index_cache
+  {
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<studio::resources::decompression_index>> indexes;
+  };
+
+  struct overlay_index_cache
+  {
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<const studio::resources::overlay_index>> indexes;
+  };
+
   class resource_explorer
   {
   public:
@@ -36,23 +85,81 @@ namespace studio::resources
 
     std::filesystem::path get_search_path() const;
 
+    // Keeps archive listings in a file at index_path, so that they survive between runs.
+    void load_index(const std::filesystem::path& index_path);
+
+    void save_index() const;
+
     void add_archive_type(std::string extension, std::unique_ptr<studio::resources::archive_plugin> archive_type, std::optional<nonstd::span<std::string_view>> explicit_extensions = std::nullopt);
 
     std::vector<studio::resources::file_info> find_files(const std::filesystem::path& new_search_path, const std::vector<std::string_view>& extensions) const;
 
     std::vector<studio::resources::file_info> find_files(const std::vector<std::string_view>& extensions) const;
 
+    // Every file with one of the extensions under the search path, looked up by name the way the games do.
+    std::shared_ptr<const studio::resources::overlay_index> get_overlay_index(const std::vector<std::string_view>& extensions) const;
+
     file_stream load_file(const std::filesystem::path& path) const;
 
     file_stream load_file(const studio::resources::file_info& info) const;
 
+    // Like load_file, except that compressed entries which are not cached yet are decompressed as they are read.
+    // Meant for reading a small part of an entry, such as its header, where decompressing all of it would be wasted.
+    file_stream stream_file(const studio::resources::file_info& info) const;
+
+    // Every file opened with load_file or stream_file is recorded in the trace, when there is one.
+    void set_access_trace(std::shared_ptr<access_trace> new_trace);
+
+    // Decompressed entries are kept in this cache, which can be shared between explorers.
+    std::shared_ptr<blob_cache> get_blob_cache() const;
+
+    void set_blob_cache(std::shared_ptr<blob_cache> cache);
+
+    // Returns the bytes of an uncompressed archive entry, straight from a memory mapping of the archive.
+    std::optional<nonstd::span<const std::byte>> get_file_view(const studio::resources::file_info& info) const;
+
+    // Copies the file from offset bytes into it into output, and returns how many bytes were copied.
+    // Unlike load_file, this can be called from many threads at once for entries of the same archive.
+    std::size_t read_entry(const studio::resources::file_info& info, std::uint64_t offset, nonstd::span<std::byte> output) const;
+
     bool is_regular_file(const std::filesystem::path& folder_path) const;
 
     std::optional<std::reference_wrapper<studio::resources::archive_plugin>> get_archive_type(const std::filesystem::path& file_path) const;
+    // The folder an entry is written to when it is extracted into destination.
+    std::filesystem::path get_extraction_folder(const std::filesystem::path& destination, const studio::resources::file_info& info) const;
     void extract_file_contents(std::basic_istream<std::byte>& archive_file, std::filesystem::path destination, const studio::resources::file_info& info) const;
+    void extract_file_contents(std::basic_istream<std::byte>& archive_file, const studio::resources::file_info& info, std::basic_ostream<std::byte>& output) const;
     std::vector<std::variant<studio::resources::folder_info, studio::resources::file_info>> get_content_listing(const std::filesystem::path& folder_path) const;
 
+    // Finds a file which has been listed before by its full path, without regard to case.
+    std::optional<studio::resources::file_info> find_file(const std::filesystem::path& file_path) const;
+
+    // The innermost archive stored inside another archive which holds folder_path, if there is one.
+    std::optional<nested_archive> find_nested_archive(const std::filesystem::path& folder_path) const;
+
   private:
+    // The same as load_file and stream_file, except that reads made by the explorer itself are not traced.
+    file_stream open_file(const studio::resources::file_info& info) const;
+
+    file_stream open_stream(const studio::resources::file_info& info) const;
+
+    std::optional<mapped_archive> get_mapped_archive(const studio::resources::file_info& info) const;
+
+    std::shared_ptr<studio::resources::positional_file> get_positional_file(const std::filesystem::path& path) const;
+
+    // Identifies an entry in the blob cache, as long as the archive holding it still exists.
+    std::optional<std::string> get_blob_key(const studio::resources::file_info& info) const;
+
+    std::optional<std::reference_wrapper<studio::resources::archive_plugin>> get_archive_type(const studio::resources::file_info& entry) const;
+
+    // Opens the archive holding folder_path, whether it is a file of its own or an entry of another archive.
+    std::optional<std::pair<std::reference_wrapper<studio::resources::archive_plugin>, std::unique_ptr<std::basic_istream<std::byte>>>> open_archive(const std::filesystem::path& folder_path) const;
+
+    // Adds a folder for each entry of a listing which is an archive itself, so that it can be listed like any other archive.
+    void add_nested_archives(std::vector<std::variant<studio::resources::folder_info, studio::resources::file_info>>& listing) const;
+
+    std::vector<std::variant<studio::resources::folder_info, studio::resources::file_info>> list_contents(const std::filesystem::path& folder_path) const;
+
     const std::filesystem::path& search_path;
 
     std::locale default_locale;
@@ -62,7 +169,23 @@ namespace studio::resources
     std::multimap<std::string, std::unique_ptr<studio::resources::archive_plugin>> archive_types;
     std::map<std::string, std::function<void(const studio::resources::file_info&)>> actions;
 
-    mutable std::map<std::string, std::vector<studio::resources::file_info>> info_cache;
+    std::unique_ptr<listing_cache> info_cache = std::make_unique<listing_cache>();
+
+    std::unique_ptr<mapped_archive_cache> mapped_archives = std::make_unique<mapped_archive_cache>();
+
+    std::unique_ptr<workspace_index> index;
+
+    std::shared_ptr<blob_cache> blobs = std::make_shared<blob_cache>();
+
+    std::shared_ptr<access_trace> trace;
+
+    std::unique_ptr<entry_index> entries = std::make_unique<entry_index>();
+
+    std::unique_ptr<decompression_index_cache> decompression_indexes = std::make_unique<decompression_index_cache>();
+
+    std::unique_ptr<overlay_index_cache> overlay_indexes = std::make_unique<overlay_index_cache>();
+
+    std::unique_ptr<format_cache<studio::resources::archive_plugin*>> archive_formats = std::make_unique<format_cache<studio::resources::archive_plugin*>>();
   };
 }// namespace studio::resource
 
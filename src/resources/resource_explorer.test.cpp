@@ -0,0 +1,191 @@
+#include <catch2/catch.hpp>
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <string_view>
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "mapped_file.hpp"
+#include "range_stream.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("Archives inside archives are read without extracting them first", "[resources.explorer]")
+{
+  temp_folder folder("3space-nested-test");
+  auto inner_path = folder.path / "inner.tmp";
+
+  write_darkstar_vol(inner_path, { { "larmor.dts", "shape data" }, { "tribes.ppl", "pppppppppppppppppppppppppppppppppalette", studio::resources::compression_type::rle } });
+
+  std::ifstream inner_file(inner_path, std::ios::binary);
+  const std::string inner_contents{ std::istreambuf_iterator<char>(inner_file), std::istreambuf_iterator<char>() };
+  inner_file.close();
+  std::filesystem::remove(inner_path);
+
+  write_darkstar_vol(folder.path / "stored.vol", { { "readme.txt", "hello" }, { "shapes.vol", inner_contents } });
+  write_darkstar_vol(folder.path / "packed.vol", { { "shapes.vol", inner_contents, studio::resources::compression_type::rle } });
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  auto files = explorer.find_files({ ".dts", ".ppl" });
+  std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) {
+    return std::tie(a.folder_path, a.filename) < std::tie(b.folder_path, b.filename);
+  });
+
+  REQUIRE(files.size() == 4);
+  REQUIRE(files[0].folder_path == folder.path / "packed.vol" / "shapes.vol");
+  REQUIRE(files[2].folder_path == folder.path / "stored.vol" / "shapes.vol");
+
+  for (auto& file : files)
+  {
+    auto [info, stream] = explorer.load_file(file);
+    REQUIRE(to_string(*stream) == (file.filename == "larmor.dts" ? "shape data" : "pppppppppppppppppppppppppppppppppalette"));
+  }
+
+  // An uncompressed archive inside another one is a view of the same mapping.
+  auto view = explorer.get_file_view(files[2]);
+  REQUIRE(view.has_value());
+  REQUIRE(std::string_view(reinterpret_cast<const char*>(view->data()), view->size()) == "shape data");
+
+  REQUIRE_FALSE(explorer.get_file_view(files[0]).has_value());
+  REQUIRE(dynamic_cast<studio::resources::range_stream*>(explorer.load_file(files[0]).second.get()) != nullptr);
+
+  auto nested = explorer.find_nested_archive(files[0].folder_path);
+  REQUIRE(nested.has_value());
+  REQUIRE(nested->info.filename == "shapes.vol");
+  REQUIRE(nested->info.compression_type == studio::resources::compression_type::rle);
+}
+
+TEST_CASE("Compressed entries can be streamed without decompressing all of them", "[resources.explorer]")
+{
+  temp_folder folder("3space-stream-test");
+
+  std::string contents;
+
+  for (auto i = 0; contents.size() < 200 * 1024; ++i)
+  {
+    contents += "Shape " + std::to_string(i * 7919 % 1000) + " ";
+  }
+
+  write_darkstar_vol(folder.path / "shapes.vol", { { "larmor.dts", contents, studio::resources::compression_type::lzh } });
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  auto files = explorer.find_files({ "ALL" });
+  REQUIRE(files.size() == 1);
+
+  auto [info, stream] = explorer.stream_file(files[0]);
+  REQUIRE(dynamic_cast<studio::resources::decompressing_stream*>(stream.get()) != nullptr);
+
+  std::array<char, 16> header{};
+  stream->read(reinterpret_cast<std::byte*>(header.data()), header.size());
+  REQUIRE(std::string_view(header.data(), header.size()) == std::string_view(contents).substr(0, 16));
+
+  stream->seekg(150 * 1024, std::ios::beg);
+  stream->read(reinterpret_cast<std::byte*>(header.data()), header.size());
+  REQUIRE(std::string_view(header.data(), header.size()) == std::string_view(contents).substr(150 * 1024, 16));
+
+  REQUIRE(explorer.get_blob_cache()->get_stats().entry_count == 0);
+  REQUIRE(to_string(*explorer.load_file(files[0]).second) == contents);
+}
+
+TEST_CASE("Looking in a relative archive which does not exist fails rather than searching forever", "[resources.explorer]")
+{
+  temp_folder folder("3space-missing-archive-test");
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  REQUIRE(studio::resources::resource_explorer::get_archive_path("missing.vol") == "missing.vol");
+  REQUIRE_THROWS(explorer.find_files("missing.vol", { "ALL" }));
+}
+
+TEST_CASE("Scanning a large folder tree with many archives", "[resources.explorer][!benchmark]")
+{
+  temp_folder folder("3space-scan-benchmark");
+
+  const std::vector<test_entry> entries = {
+    { "a.dts", "shape" }, { "b.dts", "shape" }, { "c.bmp", "image" }, { "d.bmp", "image" }, { "e.ppl", "palette" },
+    { "f.sfx", "sound" }, { "g.sfx", "sound" }, { "h.dts", "shape" }, { "i.bmp", "image" }, { "j.dat", "data" }
+  };
+
+  for (auto i = 0; i < 20; ++i)
+  {
+    auto sub_folder = folder.path / ("folder" + std::to_string(i));
+    std::filesystem::create_directories(sub_folder);
+
+    for (auto j = 0; j < 25; ++j)
+    {
+      write_darkstar_vol(sub_folder / ("archive" + std::to_string(j) + ".vol"), entries);
+      std::ofstream(sub_folder / ("loose" + std::to_string(j) + ".bmp")) << "image";
+    }
+  }
+
+  std::size_t file_count = 0;
+
+  BENCHMARK("find_files over 500 archives")
+  {
+    studio::resources::resource_explorer explorer(folder.path);
+    explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+    file_count = explorer.find_files({ ".dts", ".bmp" }).size();
+    return file_count;
+  };
+
+  REQUIRE(file_count == 20 * 25 * 7);
+}
+
+TEST_CASE("Files can be found and loaded from many threads at once", "[resources.explorer][concurrency]")
+{
+  temp_folder folder("3space-concurrency-test");
+
+  for (auto i = 0; i < 4; ++i)
+  {
+    auto sub_folder = folder.path / ("folder" + std::to_string(i));
+    std::filesystem::create_directories(sub_folder);
+    write_darkstar_vol(sub_folder / "shapes.vol", { { "larmor.dts", "shape data" }, { "tribes.ppl", "palette" } });
+    write_darkstar_vol(sub_folder / "sounds.vol", { { "boom.sfx", "boom" } });
+  }
+
+  studio::resources::resource_explorer explorer(folder.path);
+  explorer.add_archive_type(".vol", std::make_unique<studio::resources::vol::darkstar::vol_file_archive>());
+
+  const std::vector<std::vector<std::string_view>> queries = { { ".dts" }, { ".ppl" }, { ".sfx" }, { "ALL" }, { ".dts", ".sfx" } };
+  const std::vector<std::size_t> expected_counts = { 4, 4, 4, 12, 8 };
+
+  std::atomic<int> failures = 0;
+  std::vector<std::thread> threads;
+
+  for (auto t = 0; t < 8; ++t)
+  {
+    threads.emplace_back([&, t] {
+      for (auto i = 0; i < 25; ++i)
+      {
+        const auto query = std::size_t(t + i) % queries.size();
+        auto files = explorer.find_files(queries[query]);
+
+        if (files.size() != expected_counts[query])
+        {
+          failures++;
+          continue;
+        }
+
+        auto [info, stream] = explorer.load_file(files[std::size_t(i) % files.size()]);
+
+        if (to_string(*stream).size() != info.size)
+        {
+          failures++;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  REQUIRE(failures == 0);
+}
@@ -0,0 +1,224 @@
+#include <chrono>
+#include <algorithm>
+#include "tar_writer.hpp"
+
+namespace studio::resources
+{
+  // The largest size an 11 digit octal size field can hold.
+  constexpr std::uint64_t max_ustar_size = 077777777777ull;
+
+  tar_entry_buffer::tar_entry_buffer(std::basic_ostream<std::byte>& output) : output(output)
+  {
+  }
+
+  void tar_entry_buffer::reset(std::uint64_t size)
+  {
+    remaining = size;
+    written = 0;
+  }
+
+  std::uint64_t tar_entry_buffer::get_written() const
+  {
+    return written;
+  }
+
+  tar_entry_buffer::int_type tar_entry_buffer::overflow(int_type value)
+  {
+    if (traits_type::eq_int_type(value, traits_type::eof()))
+    {
+      return traits_type::not_eof(value);
+    }
+
+    const auto byte = traits_type::to_char_type(value);
+    return xsputn(&byte, 1) == 1 ? value : traits_type::eof();
+  }
+
+  std::streamsize tar_entry_buffer::xsputn(const char_type* values, std::streamsize count)
+  {
+    // Entries cannot grow once their header has been written, so anything past the size is refused.
+    const auto to_write = std::min<std::uint64_t>(std::uint64_t(count), remaining);
+
+    if (!output.write(values, std::streamsize(to_write)))
+    {
+      return 0;
+    }
+
+    remaining -= to_write;
+    written += to_write;
+    return std::streamsize(to_write);
+  }
+
+  tar_writer::tar_writer(std::basic_ostream<std::byte>& output) : output(output), buffer(output), entry(&buffer)
+  {
+  }
+
+  namespace
+  {
+    void put_octal(nonstd::span<char> field, std::uint64_t value)
+    {
+      // Fields are zero padded octal, ending with a NUL.
+      auto index = field.size() - 1;
+      field[index] = '\0';
+
+      while (index > 0)
+      {
+        field[--index] = char('0' + (value & 7));
+        value >>= 3;
+      }
+    }
+
+    void put_string(nonstd::span<char> field, std::string_view value)
+    {
+      std::copy_n(value.begin(), std::min(value.size(), field.size()), field.begin());
+    }
+
+    // A pax record is "<length> <keyword>=<value>\n", where the length counts its own digits too.
+    std::string make_pax_record(std::string_view keyword, std::string_view value)
+    {
+      const auto base = keyword.size() + value.size() + 3;
+      auto length = base + std::to_string(base).size();
+      length = base + std::to_string(length).size();
+
+      return std::to_string(length) + " " + std::string(keyword) + "=" + std::string(value) + "\n";
+    }
+  }// namespace
+
+  void tar_writer::write_header(std::string_view name, std::string_view prefix, std::uint64_t size, std::int64_t mtime, char type)
+  {
+    std::array<char, tar_block_size> header{};
+    auto block = nonstd::span<char>(header.data(), header.size());
+
+    put_string(block.subspan(0, 100), name);
+    put_octal(block.subspan(100, 8), 0644);
+    put_octal(block.subspan(108, 8), 0);
+    put_octal(block.subspan(116, 8), 0);
+    put_octal(block.subspan(124, 12), std::min(size, max_ustar_size));
+    put_octal(block.subspan(136, 12), std::uint64_t(std::clamp<std::int64_t>(mtime, 0, 077777777777ll)));
+    std::fill_n(header.begin() + 148, 8, ' ');
+    header[156] = type;
+    put_string(block.subspan(257, 6), std::string_view("ustar\0", 6));
+    put_string(block.subspan(263, 2), "00");
+    put_string(block.subspan(345, 155), prefix);
+
+    std::uint32_t checksum = 0;
+
+    for (auto value : header)
+    {
+      checksum += std::uint8_t(value);
+    }
+
+    put_octal(block.subspan(148, 7), checksum);
+
+    output.write(reinterpret_cast<const std::byte*>(header.data()), std::streamsize(header.size()));
+  }
+
+  void tar_writer::write_padding(std::uint64_t size)
+  {
+    static const std::array<std::byte, tar_block_size> zeros{};
+
+    if (const auto remainder = size % tar_block_size; remainder != 0)
+    {
+      output.write(zeros.data(), std::streamsize(tar_block_size - remainder));
+    }
+  }
+
+  std::basic_ostream<std::byte>& tar_writer::begin_file(const std::filesystem::path& path, std::uint64_t size, std::int64_t mtime)
+  {
+    auto full_name = path.lexically_normal().generic_u8string();
+    std::string_view name = full_name;
+    std::string_view prefix;
+
+    // ustar can split a path of up to 256 characters into a prefix and a name, at a slash.
+    if (name.size() > 100)
+    {
+      for (auto slash = name.find('/'); slash != std::string_view::npos; slash = name.find('/', slash + 1))
+      {
+        if (name.size() - slash - 1 <= 100)
+        {
+          if (slash > 0 && slash <= 155 && slash + 1 < name.size())
+          {
+            prefix = name.substr(0, slash);
+            name = name.substr(slash + 1);
+          }
+
+          break;
+        }
+      }
+    }
+
+    std::string records;
+
+    if (name.size() > 100 || name.empty())
+    {
+      records += make_pax_record("path", full_name);
+      prefix = {};
+      name = std::string_view(full_name).substr(0, 100);
+    }
+
+    if (size > max_ustar_size)
+    {
+      records += make_pax_record("size", std::to_string(size));
+    }
+
+    if (!records.empty())
+    {
+      write_header("././@PaxHeader", {}, records.size(), mtime, 'x');
+      output.write(reinterpret_cast<const std::byte*>(records.data()), std::streamsize(records.size()));
+      write_padding(records.size());
+    }
+
+    write_header(name, prefix, size, mtime, '0');
+
+    entry_size = size;
+    buffer.reset(size);
+    entry.clear();
+
+    return entry;
+  }
+
+  bool tar_writer::end_file()
+  {
+    static const std::array<std::byte, tar_block_size> zeros{};
+
+    const auto written = buffer.get_written();
+    auto missing = entry_size - std::min(written, entry_size);
+
+    while (missing > 0)
+    {
+      const auto count = std::min<std::uint64_t>(missing, zeros.size());
+      output.write(zeros.data(), std::streamsize(count));
+      missing -= count;
+    }
+
+    write_padding(entry_size);
+    buffer.reset(0);
+
+    return written == entry_size && entry.good();
+  }
+
+  void tar_writer::add_file(const std::filesystem::path& path, nonstd::span<const std::byte> contents, std::int64_t mtime)
+  {
+    begin_file(path, contents.size(), mtime).write(contents.data(), std::streamsize(contents.size()));
+    end_file();
+  }
+
+  void tar_writer::finish()
+  {
+    if (finished)
+    {
+      return;
+    }
+
+    static const std::array<std::byte, tar_block_size * 2> zeros{};
+    output.write(zeros.data(), std::streamsize(zeros.size()));
+    output.flush();
+    finished = true;
+  }
+
+  std::int64_t to_unix_time(std::filesystem::file_time_type time)
+  {
+    // file_time_type has no portable epoch in C++17, so the time is carried over relative to now.
+    const auto system_time = std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::system_clock::duration>(time - std::filesystem::file_time_type::clock::now());
+    return std::chrono::duration_cast<std::chrono::seconds>(system_time.time_since_epoch()).count();
+  }
+}// namespace studio::resources
@@ -0,0 +1,71 @@
+#ifndef DARKSTARDTSCONVERTER_TAR_WRITER_HPP
+#define DARKSTARDTSCONVERTER_TAR_WRITER_HPP
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include <ostream>
+#include <filesystem>
+#include <nonstd/span.hpp>
+
+namespace studio::resources
+{
+  constexpr std::size_t tar_block_size = 512;
+
+  // Passes the contents of one tar entry through to the archive, without letting it go past the size in its header.
+  class tar_entry_buffer : public std::basic_streambuf<std::byte>
+  {
+  public:
+    explicit tar_entry_buffer(std::basic_ostream<std::byte>& output);
+
+    void reset(std::uint64_t size);
+    std::uint64_t get_written() const;
+
+  protected:
+    int_type overflow(int_type value) override;
+    std::streamsize xsputn(const char_type* values, std::streamsize count) override;
+
+  private:
+    std::basic_ostream<std::byte>& output;
+    std::uint64_t remaining = 0;
+    std::uint64_t written = 0;
+  };
+
+  // Writes files one after another into a POSIX tar archive, as a single stream which never needs to seek.
+  // Headers are ustar, with a pax header in front of entries whose path or size does not fit in one.
+  class tar_writer
+  {
+  public:
+    explicit tar_writer(std::basic_ostream<std::byte>& output);
+
+    tar_writer(const tar_writer&) = delete;
+    tar_writer& operator=(const tar_writer&) = delete;
+
+    // Starts an entry of exactly size bytes, which are written to the stream returned.
+    // path is relative to the root of the archive, and mtime is in seconds since 1970.
+    std::basic_ostream<std::byte>& begin_file(const std::filesystem::path& path, std::uint64_t size, std::int64_t mtime = 0);
+
+    // Pads the entry to a whole block. Returns false if fewer bytes were written than promised, in which case the rest are zeros.
+    bool end_file();
+
+    void add_file(const std::filesystem::path& path, nonstd::span<const std::byte> contents, std::int64_t mtime = 0);
+
+    // Writes the two empty blocks which end an archive.
+    void finish();
+
+  private:
+    void write_header(std::string_view name, std::string_view prefix, std::uint64_t size, std::int64_t mtime, char type);
+    void write_padding(std::uint64_t size);
+
+    std::basic_ostream<std::byte>& output;
+    tar_entry_buffer buffer;
+    std::basic_ostream<std::byte> entry;
+    std::uint64_t entry_size = 0;
+    bool finished = false;
+  };
+
+  // Converts a file time into the seconds since 1970 which tar headers use.
+  std::int64_t to_unix_time(std::filesystem::file_time_type time);
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_TAR_WRITER_HPP
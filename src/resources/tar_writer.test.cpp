@@ -0,0 +1,154 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include "tar_writer.hpp"
+
+namespace
+{
+  struct tar_entry
+  {
+    std::string path;
+    std::string contents;
+    char type;
+  };
+
+  std::uint64_t read_octal(std::string_view field)
+  {
+    std::uint64_t result = 0;
+
+    for (auto c : field)
+    {
+      if (c < '0' || c > '7')
+      {
+        break;
+      }
+
+      result = result * 8 + std::uint64_t(c - '0');
+    }
+
+    return result;
+  }
+
+  std::string read_string(std::string_view field)
+  {
+    return std::string(field.substr(0, field.find('\0')));
+  }
+
+  // Reads back the entries of an archive, checking every header along the way.
+  std::vector<tar_entry> read_tar(const std::string& archive)
+  {
+    std::vector<tar_entry> results;
+    std::size_t position = 0;
+
+    REQUIRE(archive.size() % studio::resources::tar_block_size == 0);
+
+    while (position + studio::resources::tar_block_size <= archive.size())
+    {
+      const auto header = std::string_view(archive).substr(position, studio::resources::tar_block_size);
+      position += studio::resources::tar_block_size;
+
+      if (header.find_first_not_of('\0') == std::string_view::npos)
+      {
+        break;
+      }
+
+      std::uint32_t checksum = 0;
+
+      for (auto i = 0u; i < header.size(); ++i)
+      {
+        checksum += i >= 148 && i < 156 ? ' ' : std::uint8_t(header[i]);
+      }
+
+      REQUIRE(read_octal(header.substr(148, 8)) == checksum);
+      REQUIRE(header.substr(257, 6) == std::string_view("ustar\0", 6));
+
+      const auto size = read_octal(header.substr(124, 12));
+      auto prefix = read_string(header.substr(345, 155));
+      auto name = read_string(header.substr(0, 100));
+
+      results.emplace_back(tar_entry{ prefix.empty() ? name : prefix + "/" + name, archive.substr(position, size), header[156] });
+      position += (size + studio::resources::tar_block_size - 1) / studio::resources::tar_block_size * studio::resources::tar_block_size;
+    }
+
+    REQUIRE(archive.size() - position == studio::resources::tar_block_size);
+    return results;
+  }
+
+  nonstd::span<const std::byte> to_span(std::string_view value)
+  {
+    return nonstd::span<const std::byte>(reinterpret_cast<const std::byte*>(value.data()), value.size());
+  }
+
+  std::string to_string(const std::basic_string<std::byte>& value)
+  {
+    return std::string(reinterpret_cast<const char*>(value.data()), value.size());
+  }
+}
+
+TEST_CASE("Files are written into a tar archive block by block", "[resources.tar_writer]")
+{
+  std::basic_stringstream<std::byte> output;
+  studio::resources::tar_writer writer(output);
+
+  const std::string large(1500, 'x');
+  const auto long_folder = std::string(120, 'f');
+  const auto long_name = std::string(130, 'n') + ".dts";
+
+  writer.add_file("shapes/larmor.dts", to_span("shape data"), 946684800);
+  writer.add_file("shapes/large.dts", to_span(large));
+  writer.add_file(long_folder + "/tribes.ppl", to_span("palette"));
+  writer.add_file(long_name, to_span("long"));
+  writer.add_file("empty.txt", {});
+  writer.finish();
+
+  auto entries = read_tar(to_string(output.str()));
+
+  REQUIRE(entries.size() == 6);
+  REQUIRE(entries[0].path == "shapes/larmor.dts");
+  REQUIRE(entries[0].contents == "shape data");
+  REQUIRE(entries[1].contents == large);
+
+  // Paths up to 256 characters are split between the prefix and the name.
+  REQUIRE(entries[2].path == long_folder + "/tribes.ppl");
+  REQUIRE(entries[2].type == '0');
+
+  // Anything longer goes in a pax header first.
+  REQUIRE(entries[3].type == 'x');
+  const auto record = "path=" + long_name + "\n";
+  REQUIRE(entries[3].contents == std::to_string(entries[3].contents.size()) + " " + record);
+  REQUIRE(entries[4].contents == "long");
+
+  REQUIRE(entries[5].path == "empty.txt");
+  REQUIRE(entries[5].contents.empty());
+
+  const auto header = to_string(output.str()).substr(0, studio::resources::tar_block_size);
+  REQUIRE(read_octal(std::string_view(header).substr(136, 12)) == 946684800);
+}
+
+TEST_CASE("Tar entries are kept to the size in their header", "[resources.tar_writer]")
+{
+  std::basic_stringstream<std::byte> output;
+  studio::resources::tar_writer writer(output);
+
+  auto& short_entry = writer.begin_file("short.txt", 8);
+  short_entry.write(to_span("abc").data(), 3);
+  REQUIRE_FALSE(writer.end_file());
+
+  auto& long_entry = writer.begin_file("long.txt", 2);
+  long_entry.write(to_span("abc").data(), 3);
+  REQUIRE_FALSE(writer.end_file());
+
+  auto& exact_entry = writer.begin_file("exact.txt", 3);
+  exact_entry.write(to_span("abc").data(), 3);
+  REQUIRE(writer.end_file());
+
+  writer.finish();
+
+  auto entries = read_tar(to_string(output.str()));
+
+  REQUIRE(entries.size() == 3);
+  REQUIRE(entries[0].contents == std::string("abc\0\0\0\0\0", 8));
+  REQUIRE(entries[1].contents == "ab");
+  REQUIRE(entries[2].contents == "abc");
+}
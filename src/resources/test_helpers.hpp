@@ -0,0 +1,176 @@
+#ifndef DARKSTARDTSCONVERTER_TEST_HELPERS_HPP
+#define DARKSTARDTSCONVERTER_TEST_HELPERS_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+#include <nonstd/span.hpp>
+#include "archive_plugin.hpp"
+#include "compression.hpp"
+
+// Builds the archives the resource tests read, byte by byte, so that no game files are needed to run them.
+namespace studio::resources::testing
+{
+  inline nonstd::span<const std::byte> to_bytes(std::string_view value)
+  {
+    return nonstd::span<const std::byte>(reinterpret_cast<const std::byte*>(value.data()), value.size());
+  }
+
+  // Writes the lowest size bytes of value, little endian.
+  inline void write_uint(std::basic_ostream<std::byte>& output, std::uint32_t value, std::size_t size)
+  {
+    for (auto i = 0u; i < size; ++i)
+    {
+      output.put(std::byte((value >> (i * 8)) & 0xff));
+    }
+  }
+
+  inline void write_uint32(std::basic_ostream<std::byte>& output, std::uint32_t value)
+  {
+    write_uint(output, value, sizeof(value));
+  }
+
+  // Writes value into a field of exactly size bytes, padded with zeros.
+  inline void write_string(std::basic_ostream<std::byte>& output, std::string_view value, std::size_t size)
+  {
+    for (auto i = 0u; i < size; ++i)
+    {
+      output.put(std::byte(i < value.size() ? value[i] : '\0'));
+    }
+  }
+
+  inline void write_string(std::basic_ostream<std::byte>& output, std::string_view value)
+  {
+    write_string(output, value, value.size());
+  }
+
+  struct test_entry
+  {
+    std::string_view filename;
+    std::string_view contents;
+    studio::resources::compression_type compression = studio::resources::compression_type::none;
+
+    std::vector<std::byte> get_block() const
+    {
+      auto bytes = to_bytes(contents);
+
+      if (compression == studio::resources::compression_type::rle)
+      {
+        return studio::resources::compress_rle(bytes);
+      }
+
+      if (compression == studio::resources::compression_type::lz)
+      {
+        return studio::resources::compress_lz(bytes);
+      }
+
+      if (compression == studio::resources::compression_type::lzh)
+      {
+        return studio::resources::compress_lzh(bytes);
+      }
+
+      return std::vector<std::byte>(bytes.begin(), bytes.end());
+    }
+  };
+
+  // Writes a minimal Darkstar VOL with the given entries.
+  inline void write_darkstar_vol(const std::filesystem::path& path, const std::vector<test_entry>& entries)
+  {
+    std::basic_ofstream<std::byte> output(path, std::ios::binary | std::ios::trunc);
+
+    std::vector<std::uint32_t> offsets;
+    std::uint32_t position = 8;
+
+    for (auto& entry : entries)
+    {
+      offsets.emplace_back(position);
+      position += 8 + std::uint32_t(entry.get_block().size());
+    }
+
+    write_string(output, " VOL");
+    write_uint32(output, position);
+
+    for (auto& entry : entries)
+    {
+      auto block = entry.get_block();
+      write_string(output, "VBLK");
+      write_uint32(output, std::uint32_t(block.size()) | 0x80000000);
+      output.write(block.data(), std::streamsize(block.size()));
+    }
+
+    std::uint32_t string_size = 0;
+
+    for (auto& entry : entries)
+    {
+      string_size += std::uint32_t(entry.filename.size()) + 1;
+    }
+
+    write_string(output, "vols");
+    write_uint32(output, 0);
+    write_string(output, "voli");
+    write_uint32(output, 0);
+    write_string(output, "vols");
+    write_uint32(output, string_size);
+
+    if (string_size % 2 != 0)
+    {
+      output.put(std::byte{ 0 });
+    }
+
+    std::uint32_t name_offset = 0;
+
+    for (auto& entry : entries)
+    {
+      write_string(output, entry.filename);
+      output.put(std::byte{ 0 });
+    }
+
+    write_string(output, "voli");
+    write_uint32(output, std::uint32_t(entries.size() * 17));
+
+    for (auto i = 0u; i < entries.size(); ++i)
+    {
+      write_uint32(output, 0);
+      write_uint32(output, name_offset);
+      write_uint32(output, offsets[i]);
+      write_uint32(output, std::uint32_t(entries[i].contents.size()));
+      output.put(std::byte(entries[i].compression));
+      name_offset += std::uint32_t(entries[i].filename.size()) + 1;
+    }
+  }
+
+  inline std::string to_string(std::basic_istream<std::byte>& stream)
+  {
+    std::string result;
+    std::transform(std::istreambuf_iterator<std::byte>(stream), std::istreambuf_iterator<std::byte>(), std::back_inserter(result), [](auto value) { return char(value); });
+    return result;
+  }
+
+  // A folder of its own under the temp directory, which is removed again however the test ends.
+  struct temp_folder
+  {
+    std::filesystem::path path;
+
+    explicit temp_folder(std::string_view name) : path(std::filesystem::temp_directory_path() / name)
+    {
+      std::filesystem::remove_all(path);
+      std::filesystem::create_directories(path);
+    }
+
+    temp_folder(const temp_folder&) = delete;
+    temp_folder& operator=(const temp_folder&) = delete;
+
+    ~temp_folder()
+    {
+      std::error_code error;
+      std::filesystem::remove_all(path, error);
+    }
+  };
+}// namespace studio::resources::testing
+
+#endif//DARKSTARDTSCONVERTER_TEST_HELPERS_HPP
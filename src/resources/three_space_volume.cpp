@@ -6,6 +6,9 @@
 #include <string>
 
 #include "three_space_volume.hpp"
+#include "compression.hpp"
+#include "record_reader.hpp"
+#include "block_copy.hpp"
 
 namespace studio::resources::vol::three_space
 {
@@ -34,6 +37,25 @@ namespace studio::resources::vol::three_space
     endian::little_int32_t offset;
   };
 
+  struct rmf_entry_header
+  {
+    std::array<char, 13> filename;
+    endian::little_uint32_t file_size;
+  };
+
+  struct vol_file_header
+  {
+    std::array<char, 13> filename;
+    std::uint8_t folder_index;
+    endian::little_uint32_t offset;
+  };
+
+  struct vol_entry_header
+  {
+    std::byte compression;
+    std::array<endian::little_uint32_t, 2> file_info;
+  };
+
   std::vector<studio::resources::folder_info> get_rmf_sub_archives(std::basic_istream<std::byte>& raw_data)
   {
     std::array<std::byte, 6> header{};
@@ -96,28 +118,34 @@ namespace studio::resources::vol::three_space
           return a.offset < b.offset;
         });
 
-        results.reserve(file_count);
+        std::vector<std::size_t> offsets;
+        offsets.reserve(file_count);
+
+        std::transform(headers.begin(), headers.end(), std::back_inserter(offsets), [](const auto& file_header) {
+          return std::size_t(file_header.offset);
+        });
 
         auto volume = std::basic_ifstream<std::byte>{ real_path / volume_filename, std::ios::binary };
 
+        const auto entry_headers = studio::resources::read_records<rmf_entry_header>(volume, offsets);
+
+        results.reserve(file_count);
+
         std::array<char, 14> child_filename{ '\0' };
 
         for (auto x = 0; x < file_count; ++x)
         {
-          auto& file_header = headers[x];
-
-          volume.seekg(file_header.offset, std::ios::beg);
+          auto& entry_header = entry_headers[x];
 
-          volume.read(reinterpret_cast<std::byte*>(child_filename.data()), child_filename.size() - 1);
-          endian::little_uint32_t file_size{};
-          volume.read(reinterpret_cast<std::byte*>(&file_size), sizeof(file_size));
+          std::copy(entry_header.filename.begin(), entry_header.filename.end(), child_filename.begin());
 
           studio::resources::file_info info{};
-          info.offset = file_header.offset;
+          info.offset = offsets[x];
           info.filename = child_filename.data();
-          info.size = file_size;
+          info.size = entry_header.file_size;
           info.folder_path = real_path / map_filename / volume_filename;
           info.compression_type = studio::resources::compression_type::none;
+          info.checksum = std::uint32_t(headers[x].checksum);
 
           results.emplace_back(info);
         }
@@ -149,9 +177,9 @@ namespace studio::resources::vol::three_space
 
     raw_data.read(reinterpret_cast<std::byte*>(&file_count), sizeof(file_count));
 
-    // The section being skipped appears to be an array of checksums.
-    // TODO verify if the checksums are crc32.
-    raw_data.seekg(file_count * sizeof(std::array<std::byte, 4>), std::ios::cur);
+    // One checksum for each file, in the same order as the files.
+    std::vector<endian::little_uint32_t> checksums(file_count);
+    raw_data.read(reinterpret_cast<std::byte*>(checksums.data()), checksums.size() * sizeof(endian::little_uint32_t));
 
     std::array<char, 14> child_filename{ '\0' };
 
@@ -173,6 +201,7 @@ namespace studio::resources::vol::three_space
 
       info.filename = child_filename.data();
       info.size = file_size;
+      info.checksum = std::uint32_t(checksums[x]);
 
       results.emplace_back(info);
       raw_data.seekg(file_size, std::ios::cur);
@@ -238,59 +267,60 @@ namespace studio::resources::vol::three_space
     endian::little_uint32_t header_size;
     raw_data.read(reinterpret_cast<std::byte*>(&header_size), sizeof(header_size));
 
+    std::vector<vol_file_header> headers(num_files, vol_file_header{});
+    raw_data.read(reinterpret_cast<std::byte*>(headers.data()), headers.size() * sizeof(vol_file_header));
+
     std::vector<studio::resources::file_info> files;
     files.reserve(num_files);
 
     std::array<char, 14> filename{ '\0' };
 
-    for (auto i = 0u; i < num_files; ++i)
+    for (auto& header : headers)
     {
       studio::resources::file_info info{};
 
-      raw_data.read(reinterpret_cast<std::byte*>(filename.data()), filename.size() - 1);
-      std::uint8_t folder_index;
-      raw_data.read(reinterpret_cast<std::byte*>(&folder_index), sizeof(folder_index));
-
-      endian::little_uint32_t offset;
-      raw_data.read(reinterpret_cast<std::byte*>(&offset), sizeof(offset));
+      std::copy(header.filename.begin(), header.filename.end(), filename.begin());
 
-      if (folder_index > folders.size() || folders.empty())
+      if (header.folder_index > folders.size() || folders.empty())
       {
         info.folder_path = folder_name;
       }
       else
       {
-        info.folder_path = folders[folder_index];
+        info.folder_path = folders[header.folder_index];
       }
 
       if (folder_name == info.folder_path.string())
       {
         info.compression_type = studio::resources::compression_type::none;
-        info.offset = offset;
+        info.offset = header.offset;
         info.filename = filename.data();
 
         files.emplace_back(info);
       }
     }
 
-    for (auto& file : files)
-    {
-      raw_data.seekg(file.offset, std::ios::beg);
+    std::vector<std::size_t> offsets;
+    offsets.reserve(files.size());
+
+    std::transform(files.begin(), files.end(), std::back_inserter(offsets), [](const auto& file) {
+      return file.offset;
+    });
 
-      std::byte entry{};
-      raw_data.read(&entry, sizeof(entry));
+    const auto entry_headers = studio::resources::read_records<vol_entry_header>(raw_data, offsets);
 
-      if (!(entry == std::byte{ 0x02 } || entry == std::byte{ 0x09 }))
+    for (auto i = 0u; i < files.size(); ++i)
+    {
+      auto& file = files[i];
+      auto& entry = entry_headers[i];
+
+      if (!(entry.compression == std::byte{ 0x02 } || entry.compression == std::byte{ 0x09 }))
       {
         throw std::invalid_argument("VOL file has corrupted data.");
       }
 
-      file.compression_type = entry == std::byte{ 0x02 } ? compression_type::none : compression_type::lz;
-
-      std::array<endian::little_uint32_t, 2> file_info{};
-      raw_data.read(reinterpret_cast<std::byte*>(&file_info), sizeof(file_info));
-
-      file.size = file_info[0];
+      file.compression_type = entry.compression == std::byte{ 0x02 } ? compression_type::none : compression_type::lz;
+      file.size = entry.file_info[0];
     }
 
     return files;
@@ -376,9 +406,12 @@ namespace studio::resources::vol::three_space
 
     set_stream_position(real_stream, info);
 
-    std::copy_n(std::istreambuf_iterator<std::byte>(real_stream),
-                info.size,
-                std::ostreambuf_iterator<std::byte>(output));
+    studio::resources::copy_bytes(real_stream, output, info.size);
+  }
+
+  std::filesystem::path rmf_file_archive::get_data_path(const std::filesystem::path&, const studio::resources::file_info& info) const
+  {
+    return info.folder_path.parent_path().parent_path() / info.folder_path.filename();
   }
 
   bool dyn_file_archive::is_supported(std::basic_istream<std::byte>& stream)
@@ -422,7 +455,7 @@ namespace studio::resources::vol::three_space
     }
     else if (int(stream.tellg()) != info.offset + sizeof(std::array<std::byte, 13>) + sizeof(endian::little_int32_t))
     {
-      stream.seekg(info.offset + sizeof(endian::little_int32_t), std::ios::beg);
+      stream.seekg(info.offset + sizeof(std::array<std::byte, 13>) + sizeof(endian::little_int32_t), std::ios::beg);
     }
   }
 
@@ -430,9 +463,7 @@ namespace studio::resources::vol::three_space
   {
     set_stream_position(stream, info);
 
-    std::copy_n(std::istreambuf_iterator<std::byte>(stream),
-      info.size,
-      std::ostreambuf_iterator<std::byte>(output));
+    studio::resources::copy_bytes(stream, output, info.size);
   }
 
   bool vol_file_archive::is_supported(std::basic_istream<std::byte>& stream)
@@ -514,8 +545,28 @@ namespace studio::resources::vol::three_space
 
     const auto remaining_bytes = last_byte - info.offset - header_size;
 
-    std::copy_n(std::istreambuf_iterator<std::byte>(stream),
-      info.size > remaining_bytes ? remaining_bytes : info.size,
-      std::ostreambuf_iterator<std::byte>(output));
+    if (info.compression_type == compression_type::none)
+    {
+      studio::resources::copy_bytes(stream, output, info.size > remaining_bytes ? remaining_bytes : info.size);
+    }
+    else
+    {
+      studio::resources::decompress(info.compression_type, stream, remaining_bytes, info.size, output);
+    }
+  }
+
+  std::unique_ptr<std::basic_istream<std::byte>> vol_file_archive::open_compressed_entry(std::unique_ptr<std::basic_istream<std::byte>> stream, const studio::resources::file_info& info, std::shared_ptr<studio::resources::decompression_index> index) const
+  {
+    stream->seekg(0, std::ios::end);
+    const auto last_byte = static_cast<std::size_t>(stream->tellg());
+
+    stream->seekg(info.offset + header_size, std::ios::beg);
+
+    if (!*stream || last_byte < info.offset + header_size)
+    {
+      return nullptr;
+    }
+
+    return std::make_unique<studio::resources::decompressing_stream>(std::move(stream), info.compression_type, last_byte - info.offset - header_size, info.size, std::move(index));
   }
-}// namespace studio::resources::vol::three_space
\ No newline at end of file
+}// namespace studio::resources::vol::three_space
@@ -17,6 +17,8 @@ namespace studio::resources::vol::three_space
     void set_stream_position(std::basic_istream<std::byte>& stream, const studio::resources::file_info& info) const override;
 
     void extract_file_contents(std::basic_istream<std::byte>& stream, const studio::resources::file_info& info, std::basic_ostream<std::byte>& output) const override;
+
+    std::filesystem::path get_data_path(const std::filesystem::path& archive_path, const studio::resources::file_info& info) const override;
   };
 
   struct dyn_file_archive : studio::resources::archive_plugin
@@ -43,6 +45,8 @@ namespace studio::resources::vol::three_space
     void set_stream_position(std::basic_istream<std::byte>& stream, const studio::resources::file_info& info) const override;
 
     void extract_file_contents(std::basic_istream<std::byte>& stream, const studio::resources::file_info& info, std::basic_ostream<std::byte>& output) const override;
+
+    std::unique_ptr<std::basic_istream<std::byte>> open_compressed_entry(std::unique_ptr<std::basic_istream<std::byte>> stream, const studio::resources::file_info& info, std::shared_ptr<studio::resources::decompression_index> index) const override;
   };
 }// namespace three_space::vol
 
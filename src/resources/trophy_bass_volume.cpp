@@ -4,6 +4,8 @@
 #include <utility>
 #include <string>
 #include "trophy_bass_volume.hpp"
+#include "record_reader.hpp"
+#include "block_copy.hpp"
 
 namespace studio::resources::vol::trophy_bass
 {
@@ -89,14 +91,29 @@ namespace studio::resources::vol::trophy_bass
       stream.seekg(-int(sizeof(padding)), std::ios::cur);
     }
 
+    std::vector<rbx_file_header> headers(num_files, rbx_file_header{});
+    stream.read(reinterpret_cast<std::byte*>(headers.data()), headers.size() * sizeof(rbx_file_header));
+
+    std::sort(headers.begin(), headers.end(), [](const auto& a, const auto& b) {
+      return a.offset < b.offset;
+    });
+
+    std::vector<std::size_t> offsets;
+    offsets.reserve(num_files);
+
+    std::transform(headers.begin(), headers.end(), std::back_inserter(offsets), [](const auto& header) {
+      return std::size_t(header.offset);
+    });
+
+    const auto file_sizes = studio::resources::read_records<endian::little_uint32_t>(stream, offsets);
+
     results.reserve(num_files);
 
     std::array<char, sizeof(rbx_file_header::filename) + 1> temp{ '\0' };
 
     for (auto i = 0u; i < num_files; ++i)
     {
-      rbx_file_header header{};
-      stream.read(reinterpret_cast<std::byte*>(&header), sizeof(header));
+      auto& header = headers[i];
 
       studio::resources::file_info info{};
 
@@ -104,29 +121,11 @@ namespace studio::resources::vol::trophy_bass
       info.filename = temp.data();
       info.compression_type = studio::resources::compression_type::none;
       info.offset = header.offset;
+      info.size = file_sizes[i];
 
       results.emplace_back(info);
     }
 
-    std::sort(results.begin(), results.end(), [](const auto& a, const auto& b) {
-      return a.offset < b.offset;
-    });
-
-    for (auto i = 0u; i < num_files; ++i)
-    {
-      auto& info = results[i];
-
-      if (int(stream.tellg()) != info.offset)
-      {
-        stream.seekg(info.offset, std::ios::beg);
-      }
-
-      endian::little_uint32_t file_size{};
-      stream.read(reinterpret_cast<std::byte*>(&file_size), sizeof(file_size));
-
-      info.size = file_size;
-    }
-
     std::vector<std::variant<folder_info, studio::resources::file_info>> final_results;
     final_results.reserve(results.size());
 
@@ -155,9 +154,7 @@ namespace studio::resources::vol::trophy_bass
   {
     set_stream_position(stream, info);
 
-    std::copy_n(std::istreambuf_iterator<std::byte>(stream),
-      info.size,
-      std::ostreambuf_iterator<std::byte>(output));
+    studio::resources::copy_bytes(stream, output, info.size);
   }
 
   bool tbv_file_archive::is_supported(std::basic_istream<std::byte>& stream)
@@ -198,41 +195,40 @@ namespace studio::resources::vol::trophy_bass
       throw std::invalid_argument("The file data provided is not a valid TBV file.");
     }
 
-    results.reserve(volume_header.num_files);
+    std::vector<tbv_file_header> headers(volume_header.num_files, tbv_file_header{});
+    stream.read(reinterpret_cast<std::byte*>(headers.data()), headers.size() * sizeof(tbv_file_header));
 
-    for (auto i = 0u; i < volume_header.num_files; ++i)
-    {
-      tbv_file_header header{};
-      stream.read(reinterpret_cast<std::byte*>(&header), sizeof(header));
-
-      studio::resources::file_info info{};
-      info.compression_type = studio::resources::compression_type::none;
-      info.offset = header.offset;
+    std::sort(headers.begin(), headers.end(), [](const auto& a, const auto& b) {
+      return a.offset < b.offset;
+    });
 
-      results.emplace_back(info);
-    }
+    std::vector<std::size_t> offsets;
+    offsets.reserve(headers.size());
 
-    std::sort(results.begin(), results.end(), [](const auto& a, const auto& b) {
-      return a.offset < b.offset;
+    std::transform(headers.begin(), headers.end(), std::back_inserter(offsets), [](const auto& header) {
+      return std::size_t(header.offset);
     });
 
+    const auto file_infos = studio::resources::read_records<tbv_file_info>(stream, offsets);
+
+    results.reserve(volume_header.num_files);
+
     std::array<char, sizeof(tbv_file_info::filename) + 1> temp{ '\0' };
 
     for (auto i = 0u; i < volume_header.num_files; ++i)
     {
-      auto& header = results[i];
+      auto& file_info = file_infos[i];
 
-      if (int(stream.tellg()) != header.offset)
-      {
-        stream.seekg(header.offset, std::ios::beg);
-      }
-      tbv_file_info info{};
-      stream.read(reinterpret_cast<std::byte*>(&info), sizeof(info));
+      std::copy(file_info.filename.begin(), file_info.filename.end(), temp.begin());
 
-      std::copy(info.filename.begin(), info.filename.end(), temp.begin());
+      studio::resources::file_info info{};
+      info.compression_type = studio::resources::compression_type::none;
+      info.offset = headers[i].offset;
+      info.filename = temp.data();
+      info.size = file_info.file_size;
+      info.checksum = std::uint32_t(headers[i].checksum);
 
-      header.filename = temp.data();
-      header.size = info.file_size;
+      results.emplace_back(info);
     }
 
     std::vector<std::variant<folder_info, studio::resources::file_info>> final_results;
@@ -263,8 +259,6 @@ namespace studio::resources::vol::trophy_bass
   {
     set_stream_position(stream, info);
 
-    std::copy_n(std::istreambuf_iterator<std::byte>(stream),
-      info.size,
-      std::ostreambuf_iterator<std::byte>(output));
+    studio::resources::copy_bytes(stream, output, info.size);
   }
 }// namespace trophy_bass::vol
\ No newline at end of file
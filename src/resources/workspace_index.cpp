@@ -0,0 +1,372 @@
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include "workspace_index.hpp"
+#include "mapped_file.hpp"
+#include "format_sniffer.hpp"
+#include "shared.hpp"
+
+namespace studio::resources
+{
+  constexpr auto index_tag = shared::to_tag<4>({ '3', 'S', 'I', 'X' });
+  constexpr std::uint64_t index_version = 2;
+
+  enum class stored_path : std::uint8_t
+  {
+    archive,
+    relative,
+    absolute
+  };
+
+  struct index_writer
+  {
+    std::vector<std::byte> data;
+
+    void write_number(std::uint64_t value)
+    {
+      while (value >= 0x80)
+      {
+        data.emplace_back(std::byte((value & 0x7f) | 0x80));
+        value >>= 7;
+      }
+
+      data.emplace_back(std::byte(value));
+    }
+
+    void write_string(std::string_view value)
+    {
+      write_number(value.size());
+      std::transform(value.begin(), value.end(), std::back_inserter(data), [](auto c) { return std::byte(c); });
+    }
+
+    // Paths inside of an archive are stored relative to it, which keeps most of them down to a single byte.
+    void write_path(const std::filesystem::path& archive_path, const std::filesystem::path& path)
+    {
+      if (path == archive_path)
+      {
+        write_number(std::uint64_t(stored_path::archive));
+        return;
+      }
+
+      auto relative = path.lexically_relative(archive_path);
+
+      if (relative.empty() || *relative.begin() == "..")
+      {
+        write_number(std::uint64_t(stored_path::absolute));
+        write_string(path.u8string());
+      }
+      else
+      {
+        write_number(std::uint64_t(stored_path::relative));
+        write_string(relative.u8string());
+      }
+    }
+  };
+
+  struct index_reader
+  {
+    nonstd::span<const std::byte> data;
+    std::size_t position = 0;
+
+    std::uint64_t read_number()
+    {
+      std::uint64_t result = 0;
+
+      for (auto shift = 0u; shift < 64; shift += 7)
+      {
+        if (position == data.size())
+        {
+          throw std::invalid_argument("The workspace index is truncated.");
+        }
+
+        const auto value = std::to_integer<std::uint64_t>(data[position++]);
+        result |= (value & 0x7f) << shift;
+
+        if ((value & 0x80) == 0)
+        {
+          return result;
+        }
+      }
+
+      throw std::invalid_argument("The workspace index is corrupted.");
+    }
+
+    std::string read_string()
+    {
+      const auto size = read_number();
+
+      if (size > data.size() - position)
+      {
+        throw std::invalid_argument("The workspace index is truncated.");
+      }
+
+      std::string result(reinterpret_cast<const char*>(data.data() + position), std::size_t(size));
+      position += std::size_t(size);
+      return result;
+    }
+
+    studio::resources::compression_type read_compression()
+    {
+      const auto value = read_number();
+
+      if (value > std::uint64_t(studio::resources::compression_type::lzh))
+      {
+        throw std::invalid_argument("The workspace index is corrupted.");
+      }
+
+      return studio::resources::compression_type(value);
+    }
+
+    std::filesystem::path read_path(const std::filesystem::path& archive_path)
+    {
+      switch (stored_path(read_number()))
+      {
+      case stored_path::archive:
+        return archive_path;
+      case stored_path::relative:
+        return archive_path / std::filesystem::u8path(read_string());
+      case stored_path::absolute:
+        return std::filesystem::u8path(read_string());
+      default:
+        throw std::invalid_argument("The workspace index is corrupted.");
+      }
+    }
+  };
+
+  workspace_index::workspace_index(std::filesystem::path index_path) : index_path(std::move(index_path))
+  {
+    load();
+  }
+
+  workspace_index::~workspace_index()
+  {
+    try
+    {
+      save();
+    }
+    catch (const std::exception&)
+    {
+      // The index is only a cache, so failing to write it is not an error.
+    }
+  }
+
+  std::map<std::filesystem::path, workspace_index::archive_record>::iterator workspace_index::find_valid_record(const std::filesystem::path& archive_path) const
+  {
+    auto existing = archives.find(archive_path);
+
+    if (existing == archives.end())
+    {
+      return existing;
+    }
+
+    auto stamp = get_file_stamp(archive_path);
+
+    if (stamp.has_value() && stamp->size == existing->second.size && stamp->last_write_time == existing->second.last_write_time)
+    {
+      return existing;
+    }
+
+    archives.erase(existing);
+    is_dirty = true;
+    return archives.end();
+  }
+
+  bool workspace_index::contains(const std::filesystem::path& archive_path) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return find_valid_record(archive_path) != archives.end();
+  }
+
+  std::optional<std::vector<workspace_index::content_info>> workspace_index::find(const std::filesystem::path& archive_path, const std::filesystem::path& folder_path) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto record = find_valid_record(archive_path);
+
+    if (record == archives.end())
+    {
+      return std::nullopt;
+    }
+
+    auto listing = record->second.listings.find(folder_path.u8string());
+
+    if (listing == record->second.listings.end())
+    {
+      return std::nullopt;
+    }
+
+    return listing->second.get_contents();
+  }
+
+  void workspace_index::insert(const std::filesystem::path& archive_path, const std::filesystem::path& folder_path, const std::vector<content_info>& listing)
+  {
+    auto stamp = get_file_stamp(archive_path);
+
+    if (!stamp.has_value())
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto& record = archives[archive_path];
+
+    if (record.size != stamp->size || record.last_write_time != stamp->last_write_time)
+    {
+      record.listings.clear();
+      record.size = stamp->size;
+      record.last_write_time = stamp->last_write_time;
+    }
+
+    record.listings[folder_path.u8string()] = entry_table(listing);
+    is_dirty = true;
+  }
+
+  void workspace_index::save() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!is_dirty)
+    {
+      return;
+    }
+
+    index_writer writer;
+    writer.data.insert(writer.data.end(), index_tag.begin(), index_tag.end());
+    writer.write_number(index_version);
+    writer.write_number(archives.size());
+
+    for (auto& [archive_path, record] : archives)
+    {
+      writer.write_string(archive_path.u8string());
+      writer.write_number(record.size);
+      writer.write_number(std::uint64_t(record.last_write_time));
+      writer.write_number(record.listings.size());
+
+      for (auto& [folder_path, listing] : record.listings)
+      {
+        writer.write_path(archive_path, std::filesystem::u8path(folder_path));
+        writer.write_number(listing.size());
+
+        for (auto i = 0u; i < listing.size(); ++i)
+        {
+          if (listing.kind(i) == entry_table::entry_kind::folder)
+          {
+            writer.write_number(0);
+            writer.write_string(listing.name(i));
+            writer.write_number(listing.file_count(i).has_value() ? listing.file_count(i).value() + 1 : 0);
+            writer.write_path(archive_path, listing.path(i));
+          }
+          else
+          {
+            writer.write_number(1);
+            writer.write_string(listing.name(i));
+            writer.write_number(listing.offset(i));
+            writer.write_number(listing.size(i));
+            writer.write_number(std::uint64_t(listing.compression(i)));
+            writer.write_path(archive_path, listing.path(i));
+            writer.write_number(listing.checksum(i).has_value() ? std::uint64_t(listing.checksum(i).value()) + 1 : 0);
+          }
+        }
+      }
+    }
+
+    std::filesystem::create_directories(index_path.parent_path());
+
+    auto temp_path = index_path;
+    temp_path += ".tmp";
+
+    {
+      std::basic_ofstream<std::byte> output(temp_path, std::ios::binary | std::ios::trunc);
+      output.write(writer.data.data(), std::streamsize(writer.data.size()));
+    }
+
+    std::filesystem::rename(temp_path, index_path);
+    is_dirty = false;
+  }
+
+  void workspace_index::load()
+  {
+    std::error_code error;
+
+    if (!std::filesystem::exists(index_path, error))
+    {
+      return;
+    }
+
+    try
+    {
+      mapped_file file(index_path);
+      index_reader reader{ file.data() };
+
+      if (reader.data.size() < index_tag.size() || !std::equal(index_tag.begin(), index_tag.end(), reader.data.begin()))
+      {
+        return;
+      }
+
+      reader.position = index_tag.size();
+
+      if (reader.read_number() != index_version)
+      {
+        return;
+      }
+
+      std::map<std::filesystem::path, archive_record> results;
+
+      for (auto archive_count = reader.read_number(); archive_count > 0; --archive_count)
+      {
+        auto archive_path = std::filesystem::u8path(reader.read_string());
+        auto& record = results[archive_path];
+        record.size = reader.read_number();
+        record.last_write_time = std::int64_t(reader.read_number());
+
+        for (auto listing_count = reader.read_number(); listing_count > 0; --listing_count)
+        {
+          auto& listing = record.listings[reader.read_path(archive_path).u8string()];
+          const auto item_count = std::size_t(reader.read_number());
+          listing.reserve(std::min(item_count, reader.data.size()));
+
+          for (auto i = 0u; i < item_count; ++i)
+          {
+            if (reader.read_number() == 0)
+            {
+              studio::resources::folder_info info{};
+              info.name = reader.read_string();
+
+              if (auto file_count = reader.read_number(); file_count > 0)
+              {
+                info.file_count = std::size_t(file_count - 1);
+              }
+
+              info.full_path = reader.read_path(archive_path);
+              listing.push_back(info);
+            }
+            else
+            {
+              studio::resources::file_info info{};
+              info.filename = std::filesystem::u8path(reader.read_string());
+              info.offset = std::size_t(reader.read_number());
+              info.size = std::size_t(reader.read_number());
+              info.compression_type = reader.read_compression();
+              info.folder_path = reader.read_path(archive_path);
+
+              if (auto checksum = reader.read_number(); checksum > 0)
+              {
+                info.checksum = std::uint32_t(checksum - 1);
+              }
+
+              listing.push_back(info);
+            }
+          }
+        }
+      }
+
+      archives = std::move(results);
+    }
+    catch (const std::exception&)
+    {
+      // A damaged index is thrown away and rebuilt from the archives.
+      archives.clear();
+    }
+  }
+}// namespace studio::resources
@@ -0,0 +1,51 @@
+#ifndef DARKSTARDTSCONVERTER_WORKSPACE_INDEX_HPP
+#define DARKSTARDTSCONVERTER_WORKSPACE_INDEX_HPP
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include <optional>
+#include <filesystem>
+#include "archive_plugin.hpp"
+#include "entry_table.hpp"
+
+namespace studio::resources
+{
+  // Archive listings persisted between runs, keyed by archive path, size and modification time.
+  // Entries are checked against the archive on disk when they are looked up, and dropped if it has changed.
+  class workspace_index
+  {
+  public:
+    using content_info = archive_plugin::content_info;
+
+    explicit workspace_index(std::filesystem::path index_path);
+    ~workspace_index();
+
+    bool contains(const std::filesystem::path& archive_path) const;
+
+    std::optional<std::vector<content_info>> find(const std::filesystem::path& archive_path, const std::filesystem::path& folder_path) const;
+
+    void insert(const std::filesystem::path& archive_path, const std::filesystem::path& folder_path, const std::vector<content_info>& listing);
+
+    void save() const;
+
+  private:
+    struct archive_record
+    {
+      std::uint64_t size;
+      std::int64_t last_write_time;
+      std::map<std::string, entry_table> listings;
+    };
+
+    std::map<std::filesystem::path, archive_record>::iterator find_valid_record(const std::filesystem::path& archive_path) const;
+
+    void load();
+
+    std::filesystem::path index_path;
+    mutable std::mutex mutex;
+    mutable bool is_dirty = false;
+    mutable std::map<std::filesystem::path, archive_record> archives;
+  };
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_WORKSPACE_INDEX_HPP
@@ -0,0 +1,113 @@
+#include <catch2/catch.hpp>
+#include <fstream>
+#include <iterator>
+#include "workspace_index.hpp"
+#include "resource_explorer.hpp"
+#include "darkstar_volume.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+namespace
+{
+  struct counting_vol_archive : studio::resources::vol::darkstar::vol_file_archive
+  {
+    inline static int listing_count = 0;
+
+    std::vector<content_info> get_content_listing(std::basic_istream<std::byte>& stream, std::filesystem::path archive_or_folder_path) const override
+    {
+      listing_count++;
+      return vol_file_archive::get_content_listing(stream, archive_or_folder_path);
+    }
+  };
+}
+
+TEST_CASE("Archive listings are reused from the workspace index until the archive changes", "[resources.workspace_index]")
+{
+  temp_folder folder("3space-index-test");
+  auto volume_path = folder.path / "sounds.vol";
+  auto index_path = folder.path / "cache" / "workspace.idx";
+
+  write_darkstar_vol(volume_path, { { "boom.sfx", "boom" }, { "hiss.sfx", "hiss" } });
+
+  auto list_files = [&] {
+    studio::resources::resource_explorer explorer(folder.path);
+    explorer.add_archive_type(".vol", std::make_unique<counting_vol_archive>());
+    explorer.load_index(index_path);
+
+    auto files = explorer.find_files({ ".sfx" });
+    explorer.save_index();
+    return files;
+  };
+
+  counting_vol_archive::listing_count = 0;
+
+  auto first = list_files();
+  REQUIRE(counting_vol_archive::listing_count == 1);
+  REQUIRE(std::filesystem::exists(index_path));
+
+  auto second = list_files();
+  REQUIRE(counting_vol_archive::listing_count == 1);
+  REQUIRE(second.size() == 2);
+
+  for (auto i = 0u; i < first.size(); ++i)
+  {
+    REQUIRE(second[i].filename == first[i].filename);
+    REQUIRE(second[i].folder_path == first[i].folder_path);
+    REQUIRE(second[i].offset == first[i].offset);
+    REQUIRE(second[i].size == first[i].size);
+  }
+
+  write_darkstar_vol(volume_path, { { "boom.sfx", "boom" }, { "hiss.sfx", "hiss" }, { "zap.sfx", "zap!!" } });
+
+  auto third = list_files();
+  REQUIRE(counting_vol_archive::listing_count == 2);
+  REQUIRE(third.size() == 3);
+}
+
+TEST_CASE("A workspace index with an unknown compression type is rebuilt", "[resources.workspace_index]")
+{
+  temp_folder folder("3space-index-compression-test");
+  auto volume_path = folder.path / "sounds.vol";
+  auto index_path = folder.path / "cache" / "workspace.idx";
+
+  write_darkstar_vol(volume_path, { { "boom.sfx", "boom" } });
+
+  auto list_files = [&] {
+    studio::resources::resource_explorer explorer(folder.path);
+    explorer.add_archive_type(".vol", std::make_unique<counting_vol_archive>());
+    explorer.load_index(index_path);
+
+    auto files = explorer.find_files({ ".sfx" });
+    explorer.save_index();
+    return files;
+  };
+
+  counting_vol_archive::listing_count = 0;
+  list_files();
+  REQUIRE(counting_vol_archive::listing_count == 1);
+
+  std::string contents;
+
+  {
+    std::ifstream input(index_path, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+  }
+
+  // The name of the entry is followed by its offset and size, which are both small enough for one byte each.
+  const auto name_position = contents.find("boom.sfx");
+  REQUIRE(name_position != std::string::npos);
+  const auto compression_position = name_position + std::string_view("boom.sfx").size() + 2;
+  REQUIRE(contents[compression_position] == char(studio::resources::compression_type::none));
+  contents[compression_position] = 0x7f;
+
+  {
+    std::ofstream output(index_path, std::ios::binary | std::ios::trunc);
+    output << contents;
+  }
+
+  auto files = list_files();
+  REQUIRE(counting_vol_archive::listing_count == 2);
+  REQUIRE(files.size() == 1);
+  REQUIRE(files.front().compression_type == studio::resources::compression_type::none);
+}
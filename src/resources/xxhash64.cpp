@@ -0,0 +1,115 @@
+#include "xxhash64.hpp"
+
+namespace studio::resources
+{
+  namespace
+  {
+    constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ull;
+    constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr std::uint64_t prime3 = 0x165667B19E3779F9ull;
+    constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ull;
+    constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ull;
+
+    constexpr std::uint64_t rotate_left(std::uint64_t value, unsigned bits)
+    {
+      return (value << bits) | (value >> (64 - bits));
+    }
+
+    // The hash is defined over little endian values, whatever the platform.
+    std::uint64_t read_uint64(const std::byte* data)
+    {
+      std::uint64_t result = 0;
+
+      for (auto i = 0u; i < sizeof(result); ++i)
+      {
+        result |= std::to_integer<std::uint64_t>(data[i]) << (i * 8);
+      }
+
+      return result;
+    }
+
+    std::uint32_t read_uint32(const std::byte* data)
+    {
+      std::uint32_t result = 0;
+
+      for (auto i = 0u; i < sizeof(result); ++i)
+      {
+        result |= std::to_integer<std::uint32_t>(data[i]) << (i * 8);
+      }
+
+      return result;
+    }
+
+    constexpr std::uint64_t round(std::uint64_t accumulator, std::uint64_t input)
+    {
+      return rotate_left(accumulator + input * prime2, 31) * prime1;
+    }
+
+    constexpr std::uint64_t merge_round(std::uint64_t accumulator, std::uint64_t value)
+    {
+      return (accumulator ^ round(0, value)) * prime1 + prime4;
+    }
+  }// namespace
+
+  std::uint64_t xxhash64(nonstd::span<const std::byte> data, std::uint64_t seed)
+  {
+    const auto* position = data.data();
+    const auto* const end = position + data.size();
+    std::uint64_t result;
+
+    if (data.size() >= 32)
+    {
+      std::uint64_t v1 = seed + prime1 + prime2;
+      std::uint64_t v2 = seed + prime2;
+      std::uint64_t v3 = seed;
+      std::uint64_t v4 = seed - prime1;
+
+      for (; end - position >= 32; position += 32)
+      {
+        v1 = round(v1, read_uint64(position));
+        v2 = round(v2, read_uint64(position + 8));
+        v3 = round(v3, read_uint64(position + 16));
+        v4 = round(v4, read_uint64(position + 24));
+      }
+
+      result = rotate_left(v1, 1) + rotate_left(v2, 7) + rotate_left(v3, 12) + rotate_left(v4, 18);
+      result = merge_round(result, v1);
+      result = merge_round(result, v2);
+      result = merge_round(result, v3);
+      result = merge_round(result, v4);
+    }
+    else
+    {
+      result = seed + prime5;
+    }
+
+    result += std::uint64_t(data.size());
+
+    for (; end - position >= 8; position += 8)
+    {
+      result ^= round(0, read_uint64(position));
+      result = rotate_left(result, 27) * prime1 + prime4;
+    }
+
+    if (end - position >= 4)
+    {
+      result ^= std::uint64_t(read_uint32(position)) * prime1;
+      result = rotate_left(result, 23) * prime2 + prime3;
+      position += 4;
+    }
+
+    for (; position < end; ++position)
+    {
+      result ^= std::to_integer<std::uint64_t>(*position) * prime5;
+      result = rotate_left(result, 11) * prime1;
+    }
+
+    result ^= result >> 33;
+    result *= prime2;
+    result ^= result >> 29;
+    result *= prime3;
+    result ^= result >> 32;
+
+    return result;
+  }
+}// namespace studio::resources
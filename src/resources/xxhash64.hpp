@@ -0,0 +1,14 @@
+#ifndef DARKSTARDTSCONVERTER_XXHASH64_HPP
+#define DARKSTARDTSCONVERTER_XXHASH64_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <nonstd/span.hpp>
+
+namespace studio::resources
+{
+  // XXH64, a fast non-cryptographic hash for telling whether two files have the same contents.
+  std::uint64_t xxhash64(nonstd::span<const std::byte> data, std::uint64_t seed = 0);
+}// namespace studio::resources
+
+#endif//DARKSTARDTSCONVERTER_XXHASH64_HPP
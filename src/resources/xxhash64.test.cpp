@@ -0,0 +1,14 @@
+#include <catch2/catch.hpp>
+#include <string_view>
+#include "xxhash64.hpp"
+#include "test_helpers.hpp"
+
+using namespace studio::resources::testing;
+
+TEST_CASE("XXH64 matches the reference implementation", "[resources.xxhash64]")
+{
+  REQUIRE(studio::resources::xxhash64(to_bytes("")) == 0xEF46DB3751D8E999ull);
+  REQUIRE(studio::resources::xxhash64(to_bytes("a")) == 0xD24EC4F1A98C6E5Bull);
+  REQUIRE(studio::resources::xxhash64(to_bytes("abc")) == 0x44BC2CF5AD770999ull);
+  REQUIRE(studio::resources::xxhash64(to_bytes("Nobody inspects the spammish repetition")) == 0xFBCEA83C8A378BF1ull);
+}
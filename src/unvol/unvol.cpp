@@ -1,40 +1,382 @@
 #include <fstream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <execution>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <map>
+#include <string_view>
 
 #include <filesystem>
-#include "resources/darkstar_volume.hpp"
+#include "resources/default_resource_explorer.hpp"
+#include "resources/archive_verifier.hpp"
+#include "resources/extraction_scheduler.hpp"
+#include "shared.hpp"
 
-int main(int, const char** argv)
+namespace fs = std::filesystem;
+
+namespace
 {
-  std::string output_folder(argv[1]);
-  auto volume = std::basic_ifstream<std::byte>{ output_folder, std::ios::binary };
+  struct extraction_job
+  {
+    const studio::resources::resource_explorer* explorer;
+    studio::resources::file_info info;
+  };
+
+  using archive_files = std::pair<const studio::resources::resource_explorer*, std::vector<studio::resources::file_info>>;
+
+  bool matches_pattern(std::string_view pattern, std::string_view value)
+  {
+    if (pattern.empty())
+    {
+      return value.empty();
+    }
+
+    if (pattern.front() == '*')
+    {
+      for (auto i = 0u; i <= value.size(); ++i)
+      {
+        if (matches_pattern(pattern.substr(1), value.substr(i)))
+        {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    if (value.empty())
+    {
+      return false;
+    }
+
+    return (pattern.front() == '?' || pattern.front() == value.front()) && matches_pattern(pattern.substr(1), value.substr(1));
+  }
+
+  // Shells on Windows do not expand wildcards, so file name patterns are expanded here.
+  std::vector<fs::path> expand_archive_paths(const std::vector<std::string_view>& arguments)
+  {
+    std::vector<fs::path> results;
+
+    for (auto argument : arguments)
+    {
+      fs::path path(argument);
+      auto filename = path.filename().string();
+
+      if (filename.find_first_of("*?") == std::string::npos)
+      {
+        results.emplace_back(std::move(path));
+        continue;
+      }
+
+      auto folder = path.has_parent_path() ? path.parent_path() : fs::current_path();
+      auto pattern = studio::shared::to_lower(filename);
+      std::vector<fs::path> matches;
+
+      for (auto& item : fs::directory_iterator(folder))
+      {
+        if (item.is_regular_file() && matches_pattern(pattern, studio::shared::to_lower(item.path().filename().string())))
+        {
+          matches.emplace_back(item.path());
+        }
+      }
+
+      if (matches.empty())
+      {
+        std::cerr << "No archives match " << argument << '\n';
+      }
+
+      std::sort(matches.begin(), matches.end());
+      results.insert(results.end(), matches.begin(), matches.end());
+    }
+
+    return results;
+  }
+}
+
+int main(int argc, const char** argv)
+{
+  std::vector<std::string_view> arguments(argv + 1, argv + argc);
+  std::vector<std::string_view> archive_arguments;
+  auto job_count = std::max(1u, std::thread::hardware_concurrency());
+  auto verify_only = false;
+  auto incremental = false;
+  auto remove_stale = false;
+  fs::path tar_path;
+
+  for (auto i = 0u; i < arguments.size(); ++i)
+  {
+    if ((arguments[i] == "--jobs" || arguments[i] == "-j") && i + 1 < arguments.size())
+    {
+      job_count = std::max(1, std::atoi(std::string(arguments[++i]).c_str()));
+    }
+    else if (arguments[i] == "--verify")
+    {
+      verify_only = true;
+    }
+    else if (arguments[i] == "--incremental")
+    {
+      incremental = true;
+    }
+    else if (arguments[i] == "--remove-stale")
+    {
+      incremental = remove_stale = true;
+    }
+    else if (arguments[i] == "--tar" && i + 1 < arguments.size())
+    {
+      tar_path = fs::path(arguments[++i]);
+    }
+    else
+    {
+      archive_arguments.emplace_back(arguments[i]);
+    }
+  }
+
+  if (archive_arguments.empty())
+  {
+    std::cerr << "Usage: unvol [--jobs N] [--verify] [--tar output.tar] [--incremental] [--remove-stale] <archive or pattern>...\n";
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // The explorers keep a reference to their search path, so the paths must not move.
+  // They are absolute, since an archive given by name alone has no parent path to extract into.
+  const auto archive_paths = expand_archive_paths(archive_arguments);
+  std::vector<fs::path> search_paths;
+  search_paths.reserve(archive_paths.size());
+
+  std::vector<studio::resources::resource_explorer> explorers;
+  explorers.reserve(archive_paths.size());
+
+  std::vector<extraction_job> jobs;
+
+  for (auto& archive_path : archive_paths)
+  {
+    const auto absolute_path = fs::absolute(archive_path).lexically_normal();
+    auto& explorer = explorers.emplace_back(studio::resources::create_default_resource_explorer(search_paths.emplace_back(absolute_path.parent_path())));
+
+    try
+    {
+      for (auto& info : explorer.find_files(absolute_path, { "ALL" }))
+      {
+        jobs.emplace_back(extraction_job{ &explorer, std::move(info) });
+      }
+    }
+    catch (const std::exception& ex)
+    {
+      std::cerr << "Could not read " << archive_path << ": " << ex.what() << '\n';
+    }
+  }
+
+  // Each archive has its own explorer, so the entries are grouped by archive.
+  std::vector<archive_files> groups;
+
+  for (auto& job : jobs)
+  {
+    if (groups.empty() || groups.back().first != job.explorer)
+    {
+      groups.emplace_back(job.explorer, std::vector<studio::resources::file_info>{});
+    }
+
+    groups.back().second.emplace_back(job.info);
+  }
 
-  auto archive = studio::resources::vol::darkstar::vol_file_archive();
-  auto files = archive.get_content_listing(volume, output_folder);
+  if (verify_only)
+  {
+    // The groups are verified in parallel too.
+    std::vector<studio::resources::verification_summary> results(groups.size());
+
+    std::transform(std::execution::par, groups.begin(), groups.end(), results.begin(), [](const auto& group) {
+      return studio::resources::verify_files(*group.first, group.second);
+    });
+
+    studio::resources::verification_summary summary{};
+
+    for (auto& result : results)
+    {
+      summary.valid_files += result.valid_files;
+      summary.invalid_files += result.invalid_files;
+      summary.unreadable_files += result.unreadable_files;
+      summary.unchecked_files += result.unchecked_files;
+      summary.unconfirmed_files += result.unconfirmed_files;
+      summary.checked_bytes += result.checked_bytes;
+      summary.failures.insert(summary.failures.end(), result.failures.begin(), result.failures.end());
+    }
+
+    for (auto& failure : summary.failures)
+    {
+      const auto file_path = (failure.info.folder_path / failure.info.filename).string();
+
+      if (failure.status == studio::resources::checksum_status::invalid)
+      {
+        std::cerr << "Checksum mismatch in " << file_path << std::hex << ": expected " << failure.info.checksum.value() << ", got " << failure.actual_checksum << std::dec << '\n';
+      }
+      else
+      {
+        std::cerr << "Could not read " << file_path << '\n';
+      }
+    }
 
-  if (auto index = output_folder.find(".vol"); index != std::string::npos)
+    const auto seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-6);
+    const auto megabytes = double(summary.checked_bytes) / (1024 * 1024);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Verified " << summary.valid_files << " files, " << summary.invalid_files << " mismatched, " << summary.unreadable_files << " unreadable, "
+              << summary.unchecked_files << " without a checksum, " << summary.unconfirmed_files << " mismatched under an unconfirmed checksum algorithm, in " << seconds << "s\n"
+              << megabytes / seconds << " MB/s\n";
+
+    return summary.invalid_files == 0 && summary.unreadable_files == 0 ? 0 : 1;
+  }
+
+  if (!tar_path.empty() || incremental)
   {
-    output_folder.replace(index, 4, "");
+    // Tar files and incremental runs go through the extraction scheduler, with a reader and a writer for each job, though a tar file only ever has one writer.
+    studio::resources::extraction_options options{};
+    options.reader_count = options.writer_count = job_count;
+    options.incremental = incremental;
+    options.remove_stale = remove_stale;
+
+    // One tar file takes every archive, while each folder extracted into keeps its own manifest.
+    std::map<fs::path, std::vector<const archive_files*>> destinations;
+
+    if (!tar_path.empty())
+    {
+      options.target = studio::resources::extraction_target::tar;
+    }
+
+    for (auto& group : groups)
+    {
+      destinations[tar_path.empty() ? group.first->get_search_path() : tar_path].emplace_back(&group);
+    }
+
+    studio::resources::extraction_progress totals{};
+    auto succeeded = true;
+
+    for (auto& [destination, destination_groups] : destinations)
+    {
+      studio::resources::extraction_scheduler scheduler(*destination_groups.front()->first, destination, options);
+
+      for (auto* group : destination_groups)
+      {
+        scheduler.add_files(*group->first, group->second);
+      }
+
+      scheduler.start();
+      scheduler.wait();
+
+      for (auto& error : scheduler.get_errors())
+      {
+        std::cerr << error << '\n';
+        succeeded = false;
+      }
+
+      auto progress = scheduler.get_progress();
+      totals.extracted_files += progress.extracted_files;
+      totals.extracted_bytes += progress.extracted_bytes;
+      totals.skipped_files += progress.skipped_files;
+      totals.removed_files += progress.removed_files;
+    }
+
+    const auto seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-6);
+    const auto megabytes = double(totals.extracted_bytes) / (1024 * 1024);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Extracted " << totals.extracted_files << " files (" << megabytes << " MB) from " << archive_paths.size() << " archives";
+
+    if (!tar_path.empty())
+    {
+      std::cout << " into " << tar_path.string();
+    }
+
+    std::cout << " in " << seconds << "s using " << job_count << " threads\n"
+              << megabytes / seconds << " MB/s, " << double(totals.extracted_files) / seconds << " files/s\n";
+
+    if (incremental)
+    {
+      std::cout << totals.skipped_files << " files were already up to date, " << totals.removed_files << " stale files were removed\n";
+    }
+
+    return succeeded ? 0 : 1;
   }
 
-  if (auto index = output_folder.find(".VOL"); index != std::string::npos)
+  // Entries are extracted in the order they are stored, so each thread reads its archives mostly forwards.
+  std::stable_sort(jobs.begin(), jobs.end(), [](const auto& a, const auto& b) {
+    return a.explorer == b.explorer ? a.info.offset < b.info.offset : a.explorer < b.explorer;
+  });
+
+  // Creating the same folders from several threads at once is not reliable with every standard library,
+  // so all of them are made up front.
+  std::set<fs::path> folders;
+
+  for (auto& job : jobs)
   {
-    output_folder.replace(index, 4, "");
+    if (auto folder = job.explorer->get_extraction_folder(job.explorer->get_search_path(), job.info); folders.insert(folder).second)
+    {
+      fs::create_directories(folder);
+    }
   }
 
-  for (auto& some_file : files)
+  std::atomic<std::size_t> next_job = 0;
+  std::atomic<std::size_t> extracted_files = 0;
+  std::atomic<std::uint64_t> extracted_bytes = 0;
+  std::atomic<std::size_t> failed_files = 0;
+
+  auto extract_files = [&]() {
+    std::map<fs::path, std::basic_ifstream<std::byte>> readers;
+
+    for (auto i = next_job++; i < jobs.size(); i = next_job++)
+    {
+      auto& job = jobs[i];
+      auto archive_path = studio::resources::resource_explorer::get_archive_path(job.info.folder_path);
+
+      auto reader = readers.find(archive_path);
+
+      if (reader == readers.end())
+      {
+        reader = readers.emplace(archive_path, std::basic_ifstream<std::byte>(archive_path, std::ios::binary)).first;
+      }
+
+      try
+      {
+        job.explorer->extract_file_contents(reader->second, job.explorer->get_search_path(), job.info);
+        extracted_files++;
+        extracted_bytes += job.info.size;
+      }
+      catch (const std::exception& ex)
+      {
+        std::cerr << "Could not extract " << (job.info.folder_path / job.info.filename) << ": " << ex.what() << '\n';
+        failed_files++;
+      }
+
+      reader->second.clear();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(job_count - 1);
+
+  for (auto i = 1u; i < job_count; ++i)
   {
-    std::visit([&](auto& info) {
-           using info_type = std::decay_t<decltype(info)>;
+    threads.emplace_back(extract_files);
+  }
 
-           if constexpr (std::is_same_v<info_type, studio::resources::file_info>)
-           {
-             auto final_folder = output_folder / std::filesystem::relative(info.folder_path, output_folder);
-             std::filesystem::create_directories(final_folder);
-             auto filename = final_folder / info.filename;
-             auto new_stream = std::basic_ofstream<std::byte>{ filename, std::ios::binary };
-             archive.extract_file_contents(volume, info, new_stream);
-           }
-    }, some_file);
+  extract_files();
+
+  for (auto& thread : threads)
+  {
+    thread.join();
   }
-}
\ No newline at end of file
+
+  const auto seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-6);
+  const auto megabytes = double(extracted_bytes) / (1024 * 1024);
+
+  std::cout << std::fixed << std::setprecision(2)
+            << "Extracted " << extracted_files << " files (" << megabytes << " MB) from " << archive_paths.size() << " archives in " << seconds << "s using " << job_count << " threads\n"
+            << megabytes / seconds << " MB/s, " << double(extracted_files) / seconds << " files/s\n";
+
+  return failed_files == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include <filesystem>
+#include "resources/default_resource_explorer.hpp"
+#include "resources/archive_diff.hpp"
+
+namespace fs = std::filesystem;
+
+int main(int argc, const char** argv)
+{
+  std::vector<std::string_view> arguments(argv + 1, argv + argc);
+  auto summary_only = false;
+  std::vector<fs::path> paths;
+
+  for (auto argument : arguments)
+  {
+    if (argument == "--summary")
+    {
+      summary_only = true;
+    }
+    else
+    {
+      paths.emplace_back(argument);
+    }
+  }
+
+  if (paths.size() != 2)
+  {
+    std::cerr << "Usage: voldiff [--summary] <before folder or archive> <after folder or archive>\n";
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // A folder is compared as a whole install, and an archive by its entries alone, so that two archives with different names can be compared.
+  // The explorers keep a reference to their search path, so the paths must not move.
+  std::array<fs::path, 2> search_paths;
+
+  for (auto i = 0u; i < paths.size(); ++i)
+  {
+    search_paths[i] = fs::is_directory(paths[i]) ? paths[i] : paths[i].parent_path();
+  }
+
+  auto before_explorer = studio::resources::create_default_resource_explorer(search_paths[0]);
+  auto after_explorer = studio::resources::create_default_resource_explorer(search_paths[1]);
+
+  auto find_files = [](const studio::resources::resource_explorer& explorer, const fs::path& path) {
+    return fs::is_directory(path) ? explorer.find_files({ "ALL" }) : explorer.find_files(path, { "ALL" });
+  };
+
+  studio::resources::archive_diff diff{};
+
+  try
+  {
+    diff = studio::resources::diff_files({ before_explorer, paths[0], find_files(before_explorer, paths[0]) },
+      { after_explorer, paths[1], find_files(after_explorer, paths[1]) });
+  }
+  catch (const std::exception& ex)
+  {
+    std::cerr << ex.what() << '\n';
+    return 1;
+  }
+
+  std::size_t added = 0;
+  std::size_t removed = 0;
+  std::size_t changed = 0;
+
+  for (auto& entry : diff.entries)
+  {
+    switch (entry.status)
+    {
+    case studio::resources::diff_status::added:
+      added++;
+      break;
+    case studio::resources::diff_status::removed:
+      removed++;
+      break;
+    case studio::resources::diff_status::changed:
+      changed++;
+      break;
+    }
+
+    if (summary_only)
+    {
+      continue;
+    }
+
+    if (entry.status == studio::resources::diff_status::added)
+    {
+      std::cout << "+ " << entry.path.generic_string() << '\n';
+    }
+    else if (entry.status == studio::resources::diff_status::removed)
+    {
+      std::cout << "- " << entry.path.generic_string() << '\n';
+    }
+    else
+    {
+      std::cout << "M " << entry.path.generic_string() << " (" << entry.before->size << " -> " << entry.after->size << " bytes)\n";
+    }
+  }
+
+  for (auto& error : diff.errors)
+  {
+    std::cerr << "Could not compare " << error << '\n';
+  }
+
+  const auto seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-6);
+  const auto megabytes = double(diff.hashed_bytes) / (1024 * 1024);
+
+  std::cout << std::fixed << std::setprecision(2)
+            << added << " added, " << removed << " removed, " << changed << " changed, " << diff.unchanged_files << " unchanged\n"
+            << "Hashed " << diff.hashed_files << " pairs of files (" << megabytes << " MB) in " << seconds << "s, " << megabytes / seconds << " MB/s\n";
+
+  return diff.errors.empty() ? 0 : 2;
+}